@@ -82,15 +82,23 @@ namespace
     bool plot_files_output;
     int  checkpoint_nfiles;
     int  regrid_on_restart;
+    int  redistribute_on_restart;
     int  use_efficient_regrid;
+    int  use_incremental_dm;
     int  plotfile_on_restart;
     int  checkpoint_on_restart;
+    int  checkpoint_delta;
     bool checkpoint_files_output;
     int  compute_new_dt_on_regrid;
     bool precreateDirectories;
     bool prereadFAHeaders;
     VisMF::Header::Version plot_headerversion(VisMF::Header::Version_v1);
     VisMF::Header::Version checkpoint_headerversion(VisMF::Header::Version_v1);
+    //
+    // With asynchronous writes the temporary directories are renamed
+    // in asyncOutputFence().  [temporary name, final name]
+    //
+    Array<std::pair<std::string, std::string> > asyncRenames;
 
 }
 
@@ -109,9 +117,12 @@ Amr::Initialize ()
     plot_files_output        = true;
     checkpoint_nfiles        = 64;
     regrid_on_restart        = 0;
+    redistribute_on_restart  = 0;
     use_efficient_regrid     = 0;
+    use_incremental_dm       = 0;
     plotfile_on_restart      = 0;
     checkpoint_on_restart    = 0;
+    checkpoint_delta         = 0;
     checkpoint_files_output  = true;
     compute_new_dt_on_regrid = 0;
     precreateDirectories     = true;
@@ -155,6 +166,12 @@ Amr::RegridOnRestart () const
     return regrid_on_restart;
 }
 
+bool
+Amr::RedistributeOnRestart () const
+{
+    return redistribute_on_restart;
+}
+
 void
 Amr::setDtMin (const Array<Real>& dt_min_in)
 {
@@ -240,9 +257,12 @@ Amr::InitAmr ()
     // Check for command line flags.
     //
     pp.query("regrid_on_restart",regrid_on_restart);
+    pp.query("redistribute_on_restart",redistribute_on_restart);
     pp.query("use_efficient_regrid",use_efficient_regrid);
+    pp.query("use_incremental_dm",use_incremental_dm);
     pp.query("plotfile_on_restart",plotfile_on_restart);
     pp.query("checkpoint_on_restart",checkpoint_on_restart);
+    pp.query("checkpoint_delta",checkpoint_delta);
 
     pp.query("compute_new_dt_on_regrid",compute_new_dt_on_regrid);
 
@@ -588,6 +608,8 @@ Amr::deleteDerivePlotVar (const std::string& name)
 
 Amr::~Amr ()
 {
+    asyncOutputFence();
+
     levelbld->variableCleanUp();
 
     Amr::Finalize();
@@ -705,6 +727,8 @@ Amr::writePlotFile ()
     BL_PROFILE_REGION_START("Amr::writePlotFile()");
     BL_PROFILE("Amr::writePlotFile()");
 
+    asyncOutputFence();
+
     VisMF::SetNOutFiles(plot_nfiles);
     VisMF::Header::Version currentVersion(VisMF::GetHeaderVersion());
     VisMF::SetHeaderVersion(plot_headerversion);
@@ -794,10 +818,14 @@ Amr::writePlotFile ()
     }
     ParallelDescriptor::Barrier("Amr::writePlotFile::end");
 
-    if(ParallelDescriptor::IOProcessor()) {
-      std::rename(pltfileTemp.c_str(), pltfile.c_str());
+    if(VisMF::GetAsyncWrite()) {
+      asyncRenames.push_back(std::make_pair(pltfileTemp, pltfile));
+    } else {
+      if(ParallelDescriptor::IOProcessor()) {
+        std::rename(pltfileTemp.c_str(), pltfile.c_str());
+      }
+      ParallelDescriptor::Barrier("Renaming temporary plotfile.");
     }
-    ParallelDescriptor::Barrier("Renaming temporary plotfile.");
     //
     // the plotfile file now has the regular name
     //
@@ -819,6 +847,8 @@ Amr::writeSmallPlotFile ()
     BL_PROFILE_REGION_START("Amr::writeSmallPlotFile()");
     BL_PROFILE("Amr::writeSmallPlotFile()");
 
+    asyncOutputFence();
+
     VisMF::SetNOutFiles(plot_nfiles);
     VisMF::Header::Version currentVersion(VisMF::GetHeaderVersion());
     VisMF::SetHeaderVersion(plot_headerversion);
@@ -919,10 +949,14 @@ Amr::writeSmallPlotFile ()
     }
     ParallelDescriptor::Barrier("Amr::writeSmallPlotFile::end");
 
-    if(ParallelDescriptor::IOProcessor()) {
-      std::rename(pltfileTemp.c_str(), pltfile.c_str());
+    if(VisMF::GetAsyncWrite()) {
+      asyncRenames.push_back(std::make_pair(pltfileTemp, pltfile));
+    } else {
+      if(ParallelDescriptor::IOProcessor()) {
+        std::rename(pltfileTemp.c_str(), pltfile.c_str());
+      }
+      ParallelDescriptor::Barrier("Renaming temporary plotfile.");
     }
-    ParallelDescriptor::Barrier("Renaming temporary plotfile.");
     //
     // the plotfile file now has the regular name
     //
@@ -934,6 +968,25 @@ Amr::writeSmallPlotFile ()
   BL_PROFILE_REGION_STOP("Amr::writeSmallPlotFile()");
 }
 
+void
+Amr::asyncOutputFence ()
+{
+    VisMF::AsyncWriteFence();
+
+    if(asyncRenames.empty()) {
+      return;
+    }
+
+    if(ParallelDescriptor::IOProcessor()) {
+      for(int i(0); i < asyncRenames.size(); ++i) {
+        std::rename(asyncRenames[i].first.c_str(), asyncRenames[i].second.c_str());
+      }
+    }
+    ParallelDescriptor::Barrier("Renaming temporary output files.");
+
+    asyncRenames.clear();
+}
+
 void
 Amr::checkInput ()
 {
@@ -1562,6 +1615,8 @@ Amr::checkPoint ()
     BL_PROFILE_REGION_START("Amr::checkPoint()");
     BL_PROFILE("Amr::checkPoint()");
 
+    asyncOutputFence();
+
     VisMF::SetNOutFiles(checkpoint_nfiles);
     //
     // In checkpoint files always write out FABs in NATIVE format.
@@ -1573,6 +1628,12 @@ Amr::checkPoint ()
     VisMF::Header::Version currentVersion(VisMF::GetHeaderVersion());
     VisMF::SetHeaderVersion(checkpoint_headerversion);
 
+    //
+    // Checkpoints must restart bit for bit, so never use a lossy codec.
+    //
+    VisMF::Codec currentCodec(VisMF::GetCodec());
+    VisMF::SetCodec(VisMF::LosslessCodec);
+
     Real dCheckPointTime0 = ParallelDescriptor::second();
 
     const std::string& ckfile = amrex::Concatenate(check_file_root,level_steps[0],file_name_digits);
@@ -1585,6 +1646,14 @@ Amr::checkPoint ()
         runlog << "CHECKPOINT: file = " << ckfile << '\n';
     }
 
+    //
+    // With delta checkpoints the unchanged state data is not written,
+    // the Header names it in the checkpoint where it was last written.
+    // Tools/C_util/ConsolidateCheckPoint makes such a checkpoint whole.
+    //
+    StateData::SetDeltaCheckPoint(checkpoint_delta ? ckfile.substr(ckfile.rfind('/') + 1)
+                                                   : std::string());
+
 
   amrex::StreamRetry sretry(ckfile, abort_on_stream_retry_failure,
                              stream_max_tries);
@@ -1705,10 +1774,14 @@ Amr::checkPoint ()
     }
     ParallelDescriptor::Barrier("Amr::checkPoint::end");
 
-    if(ParallelDescriptor::IOProcessor()) {
-      std::rename(ckfileTemp.c_str(), ckfile.c_str());
+    if(VisMF::GetAsyncWrite()) {
+      asyncRenames.push_back(std::make_pair(ckfileTemp, ckfile));
+    } else {
+      if(ParallelDescriptor::IOProcessor()) {
+        std::rename(ckfileTemp.c_str(), ckfile.c_str());
+      }
+      ParallelDescriptor::Barrier("Renaming temporary checkPoint file.");
     }
-    ParallelDescriptor::Barrier("Renaming temporary checkPoint file.");
 
   }  // end while
 
@@ -1718,6 +1791,8 @@ Amr::checkPoint ()
   FArrayBox::setFormat(thePrevFormat);
 
   VisMF::SetHeaderVersion(currentVersion);
+  VisMF::SetCodec(currentCodec);
+  StateData::SetDeltaCheckPoint(std::string());
 
   BL_PROFILE_REGION_STOP("Amr::checkPoint()");
 }
@@ -2305,7 +2380,17 @@ Amr::regrid (int  lbase,
         //
 
 	if (new_dmap[lev].empty()) {
-	    new_dmap[lev].define(new_grid_places[lev]);
+	    if (use_incremental_dm && !initial && amr_level[lev]) {
+		//
+		// Keep the new grids on the processes that own the old data
+		// so that init() has as little data to move as possible.
+		//
+		new_dmap[lev] = DistributionMapping::makeIncremental(new_grid_places[lev],
+								     amr_level[lev]->boxArray(),
+								     amr_level[lev]->DistributionMap());
+	    } else {
+		new_dmap[lev].define(new_grid_places[lev]);
+	    }
 	}
 
         AmrLevel* a = (*levelbld)(*this,lev,Geom(lev),new_grid_places[lev],
@@ -3113,9 +3198,11 @@ Amr::AddProcsToComp(int nSidecarProcs, int prevSidecarProcs) {
         allInts.push_back(probinit_natonce);
         allInts.push_back(checkpoint_nfiles);
         allInts.push_back(regrid_on_restart);
+        allInts.push_back(redistribute_on_restart);
         allInts.push_back(use_efficient_regrid);
         allInts.push_back(plotfile_on_restart);
         allInts.push_back(checkpoint_on_restart);
+        allInts.push_back(checkpoint_delta);
         allInts.push_back(compute_new_dt_on_regrid);
         allInts.push_back(use_fixed_upto_level);
 
@@ -3184,9 +3271,11 @@ Amr::AddProcsToComp(int nSidecarProcs, int prevSidecarProcs) {
         probinit_natonce           = allInts[count++];
         checkpoint_nfiles          = allInts[count++];
         regrid_on_restart          = allInts[count++];
+        redistribute_on_restart    = allInts[count++];
         use_efficient_regrid       = allInts[count++];
         plotfile_on_restart        = allInts[count++];
         checkpoint_on_restart      = allInts[count++];
+        checkpoint_delta           = allInts[count++];
         compute_new_dt_on_regrid   = allInts[count++];
         use_fixed_upto_level       = allInts[count++];
 
@@ -3297,6 +3386,7 @@ Amr::AddProcsToComp(int nSidecarProcs, int prevSidecarProcs) {
         allBools.push_back(first_smallplotfile);
         allBools.push_back(precreateDirectories);
         allBools.push_back(prereadFAHeaders);
+        allBools.push_back(distributed_clustering);
 
 	// ---- sync vismf settings
         allBools.push_back(VisMF::GetGroupSets());
@@ -3330,6 +3420,7 @@ Amr::AddProcsToComp(int nSidecarProcs, int prevSidecarProcs) {
         first_smallplotfile           = allBools[count++];
         precreateDirectories          = allBools[count++];
         prereadFAHeaders              = allBools[count++];
+        distributed_clustering        = allBools[count++];
 
         VisMF::SetGroupSets(allBools[count++]);
         VisMF::SetSetBuf(allBools[count++]);
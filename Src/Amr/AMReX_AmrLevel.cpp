@@ -308,6 +308,19 @@ AmrLevel::restart (Amr&          papa,
         grids.readFrom(is);
     }
 
+    if (parent->RedistributeOnRestart())
+    {
+        //
+        // Chop the checkpointed grids to max_grid_size, and further if
+        // there are fewer of them than processors.  Each processor then
+        // reads its pieces directly from the checkpoint.
+        //
+        grids.maxSize(parent->maxGridSize(level));
+        if (grids.size() < ParallelDescriptor::NProcs()) {
+            parent->ChopGrids(level, grids, ParallelDescriptor::NProcs());
+        }
+    }
+
     int nstate;
     is >> nstate;
     int ndesc = desc_lst.size();
@@ -9,6 +9,7 @@
 #include <AMReX_StateDescriptor.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_Utility.H>
+#include <AMReX_FabChecksum.H>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -23,6 +24,39 @@ const int MFOLDDATA = 1;
 
 Array<std::string> StateData::fabArrayHeaderNames;
 std::map<std::string, Array<char> > *StateData::faHeaderMap;
+std::string StateData::deltaCheckPointDir;
+
+namespace
+{
+    //
+    // A checksum of all the data of mf, independent of the
+    // DistributionMapping.  The per fab hashes are summed as 32 bit
+    // halves so the reduction can not overflow, and the sums are
+    // hashed again so every bit of them reaches every bit of the value.
+    //
+    uint64_t
+    checksum (const MultiFab& mf)
+    {
+        long sums[2] = { 0, 0 };
+
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            FabChecksum fc(mfi.index());
+            fc.update(mf[mfi].dataPtr(), mf[mfi].box().numPts() * mf.nComp() * sizeof(Real));
+
+            const uint64_t h = fc.value();
+            sums[0] += static_cast<long>(h & 0xffffffffULL);
+            sums[1] += static_cast<long>(h >> 32);
+        }
+
+        ParallelDescriptor::ReduceLongSum(sums, 2);
+
+        FabChecksum fc(mf.nComp());
+        fc.update(sums, sizeof(sums));
+
+        return fc.value();
+    }
+}
 
 
 StateData::StateData () 
@@ -209,20 +243,22 @@ StateData::restart (std::istream&          is,
         grids.convert(typ);
     }
 
+    bool chopped(false);
     {
 	Box domain_in;
 	BoxArray grids_in;
 	is >> domain_in;
 	grids_in.readFrom(is);
 	BL_ASSERT(domain_in == domain);
-	BL_ASSERT(amrex::match(grids_in,grids));
+	chopped = ! amrex::match(grids_in,grids);
+	BL_ASSERT( ! chopped || grids_in.contains(grids));
     }
 
-    restartDoit(is, chkfile);
+    restartDoit(is, chkfile, chopped);
 }
 
 void 
-StateData::restartDoit (std::istream& is, const std::string& chkfile)
+StateData::restartDoit (std::istream& is, const std::string& chkfile, bool chopped)
 {
     BL_PROFILE("StateData::restartDoit()");
 
@@ -283,7 +319,11 @@ StateData::restartDoit (std::istream& is, const std::string& chkfile)
 	}
       }
 
-      VisMF::Read(*whichMF, FullPathName, faHeader);
+      if (chopped) {
+          VisMF::ReadChopped(*whichMF, FullPathName, faHeader);
+      } else {
+          VisMF::Read(*whichMF, FullPathName, faHeader);
+      }
     }
 }
 
@@ -713,15 +753,30 @@ StateData::checkPoint (const std::string& name,
     {
         dump_old = false;
     }
+    //
+    // The relative name gets written to the Header file.
+    //
+    std::string mf_name_old(name + OldSuffix);
+    std::string mf_name_new(name + NewSuffix);
 
-    if (ParallelDescriptor::IOProcessor())
+    bool write_new(true), write_old(dump_old);
+
+    if (desc->store_in_checkpoint() && ! deltaCheckPointDir.empty())
     {
-        //
-        // The relative name gets written to the Header file.
-        //
-        std::string mf_name_old(name + OldSuffix);
-        std::string mf_name_new(name + NewSuffix);
+        Array<CheckPointRef> refs;
+        write_new = deltaCheckPointName(*new_data, mf_name_new, refs);
+        if (dump_old) {
+            write_old = deltaCheckPointName(*old_data, mf_name_old, refs);
+        }
+        checkpoint_refs = refs;
+    }
+    else
+    {
+        checkpoint_refs.clear();
+    }
 
+    if (ParallelDescriptor::IOProcessor())
+    {
         os << domain << '\n';
 
         grids.writeOn(os);
@@ -754,10 +809,13 @@ StateData::checkPoint (const std::string& name,
     if (desc->store_in_checkpoint())
     {
        BL_ASSERT(new_data);
-       std::string mf_fullpath_new(fullpathname + NewSuffix);
-       VisMF::Write(*new_data,mf_fullpath_new,how);
+       if (write_new)
+       {
+           std::string mf_fullpath_new(fullpathname + NewSuffix);
+           VisMF::Write(*new_data,mf_fullpath_new,how);
+       }
 
-       if (dump_old)
+       if (write_old)
        {
            BL_ASSERT(old_data);
            std::string mf_fullpath_old(fullpathname + OldSuffix);
@@ -766,6 +824,33 @@ StateData::checkPoint (const std::string& name,
     }
 }
 
+bool
+StateData::deltaCheckPointName (const MultiFab&       mf,
+                                std::string&          mf_name,
+                                Array<CheckPointRef>& refs) const
+{
+    const uint64_t sum = checksum(mf);
+
+    for (int i = 0; i < checkpoint_refs.size(); ++i)
+    {
+        const CheckPointRef& ref = checkpoint_refs[i];
+        //
+        // A checkpoint written again under the same name replaces the
+        // old directory, so it can not be referred to.
+        //
+        if (ref.checksum == sum && ref.grids == grids && ref.dir != deltaCheckPointDir)
+        {
+            refs.push_back(ref);
+            mf_name = "../" + ref.dir + '/' + ref.name;
+            return false;
+        }
+    }
+
+    CheckPointRef ref = { sum, grids, deltaCheckPointDir, mf_name };
+    refs.push_back(ref);
+    return true;
+}
+
 void
 StateData::printTimeInterval (std::ostream &os) const
 {
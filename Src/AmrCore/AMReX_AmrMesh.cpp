@@ -11,6 +11,44 @@ namespace amrex {
 namespace
 {
     bool initialized = false;
+
+    //
+    // Replace bl by the boxes of bl on all processors, in processor order.
+    //
+    void
+    AllGatherBoxes (BoxList& bl)
+    {
+#ifdef BL_USE_MPI
+        const int nprocs = ParallelDescriptor::NProcs();
+        const int nints  = 2*BL_SPACEDIM;
+
+        Array<int> sendbuf;
+        sendbuf.reserve(bl.size()*nints);
+        for (const Box& b : bl)
+        {
+            for (int d = 0; d < BL_SPACEDIM; ++d) sendbuf.push_back(b.smallEnd(d));
+            for (int d = 0; d < BL_SPACEDIM; ++d) sendbuf.push_back(b.bigEnd(d));
+        }
+        int count = sendbuf.size();
+        if (sendbuf.empty()) sendbuf.resize(1);
+
+        Array<int> counts(nprocs), offsets(nprocs, 0);
+        BL_MPI_REQUIRE( MPI_Allgather(&count, 1, MPI_INT, counts.dataPtr(), 1, MPI_INT,
+                                      ParallelDescriptor::Communicator()) );
+        for (int i = 1; i < nprocs; ++i)
+            offsets[i] = offsets[i-1] + counts[i-1];
+
+        const int total = offsets[nprocs-1] + counts[nprocs-1];
+        Array<int> recvbuf(std::max(total, 1));
+        BL_MPI_REQUIRE( MPI_Allgatherv(sendbuf.dataPtr(), count, MPI_INT,
+                                       recvbuf.dataPtr(), counts.dataPtr(), offsets.dataPtr(),
+                                       MPI_INT, ParallelDescriptor::Communicator()) );
+
+        bl.clear();
+        for (int i = 0; i < total; i += nints)
+            bl.push_back(Box(IntVect(&recvbuf[i]), IntVect(&recvbuf[i+BL_SPACEDIM])));
+#endif
+    }
 }
 
 void
@@ -60,6 +98,7 @@ AmrMesh::InitAmrMesh (int max_level_in, const Array<int>& n_cell_in, std::vector
     use_fixed_coarse_grids = false;
     use_fixed_upto_level   = 0;
     refine_grid_layout     = true;
+    distributed_clustering = false;
     check_input            = true;
     
     ParmParse pp("amr");
@@ -314,6 +353,8 @@ AmrMesh::InitAmrMesh (int max_level_in, const Array<int>& n_cell_in, std::vector
 	pp.query("refine_grid_layout", refine_grid_layout);
     }
 
+    pp.query("distributed_clustering", distributed_clustering);
+
     pp.query("check_input", check_input);
 
     finest_level = -1;
@@ -617,11 +658,64 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Array<BoxArray>& n
         //
         // Create initial cluster containing all tagged points.
         //
-	std::vector<IntVect> tagvec;
-	tags.collate(tagvec);
-        tags.clear();
+        BoxList new_bx;
+        bool any_tags;
 
-        if (tagvec.size() > 0)
+        if (distributed_clustering)
+        {
+            //
+            // Each processor clusters the tags it owns.  Only the boxes
+            // are exchanged; those of different processors may overlap.
+            //
+            std::vector<TagRun> tagruns;
+            tags.collateLocal(tagruns);
+            tags.clear();
+
+            long nruns = tagruns.size();
+            ParallelDescriptor::ReduceLongSum(nruns);
+            any_tags = (nruns > 0);
+
+            if (tagruns.size() > 0)
+            {
+                ClusterList clist(tagruns);
+                clist.chop(grid_eff);
+                BoxDomain bd;
+                bd.add(p_n[levc]);
+                clist.intersect(bd);
+                bd.clear();
+                clist.boxList(new_bx);
+            }
+
+            if (any_tags && ParallelDescriptor::NProcs() > 1)
+            {
+                AllGatherBoxes(new_bx);
+                new_bx = amrex::removeOverlap(new_bx);
+            }
+        }
+        else
+        {
+            std::vector<TagRun> tagruns;
+            tags.collate(tagruns);
+            tags.clear();
+
+            any_tags = (tagruns.size() > 0);
+
+            if (any_tags)
+            {
+                //
+                // Construct initial cluster.
+                //
+                ClusterList clist(tagruns);
+                clist.chop(grid_eff);
+                BoxDomain bd;
+                bd.add(p_n[levc]);
+                clist.intersect(bd);
+                bd.clear();
+                clist.boxList(new_bx);
+            }
+        }
+
+        if (any_tags)
         {
             //
             // Created new level, now generate efficient grids.
@@ -630,20 +724,9 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Array<BoxArray>& n
                 new_finest = std::max(new_finest,levf);
 	    }
             //
-            // Construct initial cluster.
-            //
-            ClusterList clist(&tagvec[0], tagvec.size());
-            clist.chop(grid_eff);
-            BoxDomain bd;
-            bd.add(p_n[levc]);
-            clist.intersect(bd);
-            bd.clear();
-            //
             // Efficient properly nested Clusters have been constructed
             // now generate list of grids at level levf.
             //
-            BoxList new_bx;
-            clist.boxList(new_bx);
             new_bx.refine(bf_lev[levc]);
             new_bx.simplify();
             BL_ASSERT(new_bx.isDisjoint());
@@ -7,88 +7,187 @@ namespace amrex {
 
 enum CutStatus { HoleCut=0, SteepCut, BisectCut, InvalidCut };
 
+namespace
+{
+    //
+    // Orders runs by row, from the last index direction to the first.
+    //
+    struct RunLess
+    {
+        bool operator() (const TagRun& a, const TagRun& b) const
+        {
+            for (int n = BL_SPACEDIM-1; n >= 0; n--)
+            {
+                if (a.start[n] != b.start[n])
+                    return a.start[n] < b.start[n];
+            }
+            return a.len > b.len;
+        }
+    };
+
+    bool
+    sameRow (const IntVect& a, const IntVect& b)
+    {
+        for (int n = 1; n < BL_SPACEDIM; n++)
+        {
+            if (a[n] != b[n])
+                return false;
+        }
+        return true;
+    }
+
+    long
+    numCells (const std::vector<TagRun>& runs)
+    {
+        long cnt = 0;
+        for (const auto& r : runs)
+            cnt += r.len;
+        return cnt;
+    }
+
+    //
+    // Does run r have cells in b?  If so, is and ie are the first and
+    // last of them in the first direction.
+    //
+    bool
+    runInBox (const TagRun& r,
+              const Box&    b,
+              int&          is,
+              int&          ie)
+    {
+        for (int n = 1; n < BL_SPACEDIM; n++)
+        {
+            if (r.start[n] < b.smallEnd(n) || r.start[n] > b.bigEnd(n))
+                return false;
+        }
+        is = std::max(r.start[0], b.smallEnd(0));
+        ie = std::min(r.start[0] + r.len - 1, b.bigEnd(0));
+        return is <= ie;
+    }
+
+    //
+    // Divides runs into the pieces inside and outside of b.
+    //
+    void
+    splitRuns (const std::vector<TagRun>& runs,
+               const Box&                 b,
+               std::vector<TagRun>&       in,
+               std::vector<TagRun>&       out)
+    {
+        for (const auto& r : runs)
+        {
+            int is, ie;
+
+            if (!runInBox(r, b, is, ie))
+            {
+                out.push_back(r);
+                continue;
+            }
+
+            const int s = r.start[0];
+            const int e = s + r.len - 1;
+
+            TagRun piece = r;
+            if (s < is)
+            {
+                piece.len = is - s;
+                out.push_back(piece);
+            }
+            piece.start[0] = is;
+            piece.len      = ie - is + 1;
+            in.push_back(piece);
+            if (e > ie)
+            {
+                piece.start[0] = ie + 1;
+                piece.len      = e - ie;
+                out.push_back(piece);
+            }
+        }
+    }
+}
+
+void
+mergeTagRuns (std::vector<TagRun>& runs)
+{
+    if (runs.empty())
+        return;
+
+    std::sort(runs.begin(), runs.end(), RunLess());
+
+    std::vector<TagRun>::size_type m = 0;
+
+    for (std::vector<TagRun>::size_type i = 1, N = runs.size(); i < N; i++)
+    {
+        TagRun&       cur = runs[m];
+        const TagRun& r   = runs[i];
+
+        if (sameRow(cur.start,r.start) && r.start[0] <= cur.start[0] + cur.len)
+        {
+            cur.len = std::max(cur.len, r.start[0] + r.len - cur.start[0]);
+        }
+        else
+        {
+            runs[++m] = r;
+        }
+    }
+
+    runs.resize(m+1);
+}
+
 Cluster::Cluster ()
     :
-    m_ar(0) {}
+    m_len(0) {}
 
 Cluster::Cluster (IntVect* a, long len)
-    :
-    m_ar(a),
-    m_len(len)
 {
+    m_runs.resize(len);
+    for (long i = 0; i < len; i++)
+    {
+        m_runs[i].start = a[i];
+        m_runs[i].len   = 1;
+    }
+    mergeTagRuns(m_runs);
+    m_len = numCells(m_runs);
     minBox();
 }
 
-Cluster::~Cluster () {}
-
-//
-// Predicate in call to std::partition() in Cluster::Cluster(Cluster,Box).
-//
-class InBox
+Cluster::Cluster (std::vector<TagRun>& runs)
 {
-public:
-    InBox (const Box& b) : m_box(b) {}
+    m_runs.swap(runs);
+    m_len = numCells(m_runs);
+    minBox();
+}
 
-    bool operator() (const IntVect& iv) const
-    {
-        return m_box.contains(iv);
-    }
-private:
-    Box m_box;
-};
+Cluster::~Cluster () {}
 
 Cluster::Cluster (Cluster&   c,
                   const Box& b) 
     :
-    m_ar(0),
     m_len(0)
 {
     BL_ASSERT(b.ok());
-    BL_ASSERT(c.m_ar != 0 && c.m_len > 0);
+    BL_ASSERT(c.m_len > 0);
 
     if (b.contains(c.m_bx))
     {
         m_bx    = c.m_bx;
-        m_ar    = c.m_ar;
         m_len   = c.m_len;
-        c.m_ar  = 0;
+        m_runs.swap(c.m_runs);
         c.m_len = 0;
         c.m_bx  = Box();
     }
     else
     {
-        IntVect* prt_it = std::partition(c.m_ar, c.m_ar+c.m_len, InBox(b));
+        std::vector<TagRun> in, out;
 
-        if (prt_it == c.m_ar)
-        {
-            //
-            // None of the points in c.m_ar were in b.
-            //
-            m_ar  = 0;
-            m_len = 0;
-            m_bx  = Box();
-        }
-        else if (prt_it == (c.m_ar+c.m_len))
-        {
-            //
-            // All the points in c.m_ar were in b.
-            //
-            m_bx    = c.m_bx;
-            m_ar    = c.m_ar;
-            m_len   = c.m_len;
-            c.m_ar  = 0;
-            c.m_len = 0;
-            c.m_bx  = Box();
-        }
-        else
-        {
-            m_ar    = c.m_ar;
-            m_len   = prt_it - m_ar;
-            c.m_ar  = prt_it;
-            c.m_len = c.m_len - m_len;
-            minBox();
-            c.minBox();
-        }
+        splitRuns(c.m_runs, b, in, out);
+
+        m_runs.swap(in);
+        c.m_runs.swap(out);
+        m_len   = numCells(m_runs);
+        c.m_len = c.m_len - m_len;
+        minBox();
+        c.minBox();
     }
 }
 
@@ -117,10 +216,11 @@ long
 Cluster::numTag (const Box& b) const
 {
     long cnt = 0;
-    for (int i = 0; i < m_len; i++)
+    for (const auto& r : m_runs)
     {
-        if (b.contains(m_ar[i]))
-            cnt++;
+        int is, ie;
+        if (runInBox(r, b, is, ie))
+            cnt += ie - is + 1;
     }
     return cnt;
 }
@@ -134,11 +234,13 @@ Cluster::minBox ()
     }
     else
     {
-        IntVect lo = m_ar[0], hi = lo;
-        for (int i = 1; i < m_len; i++)
+        IntVect lo = m_runs[0].start, hi = lo;
+        for (const auto& r : m_runs)
         {
-            lo.min(m_ar[i]);
-            hi.max(m_ar[i]);
+            IntVect end = r.start;
+            end[0] += r.len - 1;
+            lo.min(r.start);
+            hi.max(end);
         }
         m_bx = Box(lo,hi);
     }
@@ -239,9 +341,9 @@ class Cut
 public:
     Cut (const IntVect& cut, int dir) : m_cut(cut), m_dir(dir) {}
 
-    bool operator() (const IntVect& iv) const
+    bool operator() (const TagRun& r) const
     {
-        return iv[m_dir] < m_cut[m_dir];
+        return r.start[m_dir] < m_cut[m_dir];
     }
 private:
     IntVect m_cut;
@@ -252,29 +354,32 @@ Cluster*
 Cluster::chop ()
 {
     BL_ASSERT(m_len > 1);
-    BL_ASSERT(!(m_ar == 0));
 
     const int* lo       = m_bx.loVect();
     const int* hi       = m_bx.hiVect();
     IntVect m_bx_length = m_bx.size();
     const int* len      = m_bx_length.getVect();
     //
-    // Compute histogram.
+    // Compute histogram.  A run adds one to each of its cells in the
+    // first direction, entered as +1 and -1 at its ends and summed, and
+    // its length to its row in the others.
     //
     int* hist[BL_SPACEDIM];
     for (int n = 0; n < BL_SPACEDIM; n++)
     {
-        hist[n] = new int[len[n]];
-        for (int i = 0; i < len[n]; i++)
+        hist[n] = new int[len[n]+1];
+        for (int i = 0; i <= len[n]; i++)
             hist[n][i] = 0;
     }
-    for (int n = 0; n < m_len; n++)
+    for (const auto& r : m_runs)
     {
-        const int* p = m_ar[n].getVect();
-        AMREX_D_TERM( hist[0][p[0]-lo[0]]++;,
-                hist[1][p[1]-lo[1]]++;,
-                hist[2][p[2]-lo[2]]++; )
-     }
+        const int* p = r.start.getVect();
+        AMREX_D_TERM( hist[0][p[0]-lo[0]]++; hist[0][p[0]-lo[0]+r.len]--;,
+                hist[1][p[1]-lo[1]] += r.len;,
+                hist[2][p[2]-lo[2]] += r.len; )
+    }
+    for (int i = 1; i < len[0]; i++)
+        hist[0][i] += hist[0][i-1];
     //
     // Find cutpoint and cutstatus in each index direction.
     //
@@ -314,20 +419,40 @@ Cluster::chop ()
 
     BL_ASSERT(nlo > 0 && nlo < m_len);
 
-    int nhi = m_len - nlo;
-
     for (int i = 0; i < BL_SPACEDIM; i++)
         delete [] hist[i];
 
-    IntVect* prt_it = std::partition(m_ar, m_ar+m_len, Cut(cut,dir));
+    if (dir == 0)
+    {
+        //
+        // Split the runs crossing the cut.
+        //
+        for (std::vector<TagRun>::size_type i = 0, N = m_runs.size(); i < N; i++)
+        {
+            TagRun& r = m_runs[i];
+            if (r.start[0] < cut[0] && r.start[0] + r.len > cut[0])
+            {
+                TagRun piece = r;
+                piece.start[0] = cut[0];
+                piece.len      = r.start[0] + r.len - cut[0];
+                r.len          = cut[0] - r.start[0];
+                m_runs.push_back(piece);
+            }
+        }
+    }
+
+    std::vector<TagRun>::iterator prt_it = std::partition(m_runs.begin(), m_runs.end(), Cut(cut,dir));
+
+    std::vector<TagRun> hiRuns(prt_it, m_runs.end());
+    m_runs.erase(prt_it, m_runs.end());
 
-    BL_ASSERT((prt_it-m_ar) == nlo);
-    BL_ASSERT(((m_ar+m_len)-prt_it) == nhi);
+    BL_ASSERT(numCells(m_runs) == nlo);
+    BL_ASSERT(numCells(hiRuns) == m_len - nlo);
 
     m_len = nlo;
     minBox();
 
-    return new Cluster(prt_it, nhi);
+    return new Cluster(hiRuns);
 }
 
 ClusterList::ClusterList ()
@@ -341,6 +466,11 @@ ClusterList::ClusterList (IntVect* pts,
     lst.push_back(new Cluster(pts,len));
 }
 
+ClusterList::ClusterList (std::vector<TagRun>& runs)
+{
+    lst.push_back(new Cluster(runs));
+}
+
 ClusterList::~ClusterList ()
 {
     for (std::list<Cluster*>::iterator cli = lst.begin(), End = lst.end();
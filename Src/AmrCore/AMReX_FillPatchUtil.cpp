@@ -143,12 +143,21 @@ namespace amrex
 	    
 	    const FabArrayBase::FPinfo& fpc = FabArrayBase::TheFPinfo(*fmf[0], mf, fdomain_g,
                                                                       ngrow, coarsener, 
-                                                                      amrex::coarsen(fgeom.Domain(),ratio));
+                                                                      amrex::coarsen(fgeom.Domain(),ratio),
+                                                                      fgeom.periodicity());
 
 	    if ( ! fpc.ba_crse_patch.empty())
 	    {
-		MultiFab mf_crse_patch(fpc.ba_crse_patch, fpc.dm_crse_patch, ncomp, 0, MFInfo(),
-                                       *fpc.fact_crse_patch);
+		//
+		// The staging MultiFab is reused as long as it has enough
+		// components, which also keeps the cached copy into it.
+		//
+		if (fpc.mf_crse_patch == nullptr || fpc.mf_crse_patch->nComp() < ncomp)
+		{
+		    fpc.mf_crse_patch.reset(new MultiFab(fpc.ba_crse_patch, fpc.dm_crse_patch, ncomp, 0,
+							 MFInfo(), *fpc.fact_crse_patch));
+		}
+		MultiFab& mf_crse_patch = static_cast<MultiFab&>(*fpc.mf_crse_patch);
 		
 		FillPatchSingleLevel(mf_crse_patch, time, cmf, ct, scomp, 0, ncomp, cgeom, cbc);
 		
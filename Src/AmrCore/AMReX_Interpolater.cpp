@@ -1,7 +1,10 @@
 
 #include <climits>
+#include <cmath>
+#include <algorithm>
 
 #include <AMReX_FArrayBox.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_Geometry.H>
 #include <AMReX_Interpolater.H>
 #include <AMReX_INTERP_F.H>
@@ -87,6 +90,287 @@ NodeBilinear::CoarseBox (const Box&     fine,
     return b;
 }
 
+namespace
+{
+    //
+    // Set by Interpolater::SetUseFortran, -1 for ParmParse interp.use_fortran.
+    //
+    int use_fortran_kernels = -1;
+
+    //
+    // The coarse index of fine index i, rounding down for any sign.
+    //
+    inline int
+    crseIndex (int i, int r)
+    {
+        return (i < 0) ? -((-i-1)/r) - 1 : i/r;
+    }
+
+    //
+    // Multilinear interpolation of nodal data refined by ratio.  A fine
+    // node is found from the low corner and the slopes of the coarse cell
+    // it is in, a node on the high face of the last cells from those
+    // cells, with the operations of the 3D FORT_NBINTERP in the same
+    // order.  It works one row of coarse cells at a time, so the slopes
+    // of a cell are found once, and fills only fine_region.  The unused
+    // directions have a stride of zero, so their slopes are zero.
+    //
+    void
+    nodeBilinearInterp (const FArrayBox& crse,
+                        int              crse_comp,
+                        FArrayBox&       fine,
+                        int              fine_comp,
+                        int              ncomp,
+                        const Box&       fine_region,
+                        const IntVect&   ratio)
+    {
+        int  rr[3]   = {1,1,1};
+        int  clo[3]  = {0,0,0}, cend[3] = {0,0,0};
+        int  fblo[3] = {0,0,0}, fbhi[3] = {0,0,0};
+        int  flo[3]  = {0,0,0};
+        long cstr[3] = {1,0,0}, fstr[3] = {1,0,0};
+        for (int d = 0; d < BL_SPACEDIM; d++)
+        {
+            rr[d]   = ratio[d];
+            clo[d]  = crse.box().smallEnd(d);
+            cend[d] = crse.box().bigEnd(d) - 1;
+            fblo[d] = fine_region.smallEnd(d);
+            fbhi[d] = fine_region.bigEnd(d);
+            flo[d]  = fine.box().smallEnd(d);
+            BL_ASSERT(cend[d] >= clo[d]);
+            if (d > 0)
+            {
+                cstr[d] = cstr[d-1]*crse.box().length(d-1);
+                fstr[d] = fstr[d-1]*fine.box().length(d-1);
+            }
+        }
+        const long cncomp = crse.box().numPts();
+        const long fncomp = fine.box().numPts();
+
+        const Real RX   = 1.0/rr[0];
+        const Real RY   = 1.0/rr[1];
+        const Real RZ   = 1.0/rr[2];
+        const Real RXY  = RX*RY;
+        const Real RXZ  = RX*RZ;
+        const Real RYZ  = RY*RZ;
+        const Real RXYZ = RX*RY*RZ;
+        //
+        // The coarse cell of a fine node and its offset in it.
+        //
+        auto cell = [&] (int i, int d) -> int {
+            return std::min(crseIndex(i,rr[d]), cend[d]);
+        };
+        //
+        // The cells of the row and, for each fine node of the row, the
+        // index of its cell in the row and its offset.
+        //
+        const int icl = cell(fblo[0],0);
+        const int ich = cell(fbhi[0],0);
+        const int nc  = ich - icl + 1;
+        const int nf  = fbhi[0] - fblo[0] + 1;
+        BL_ASSERT(icl >= clo[0]);
+
+        Array<int>  ics(nf);
+        Array<Real> fxs(nf);
+        for (int i = fblo[0]; i <= fbhi[0]; i++)
+        {
+            const int ic = cell(i,0);
+            ics[i-fblo[0]] = ic - icl;
+            fxs[i-fblo[0]] = i - ic*rr[0];
+        }
+
+        Array<Real> c(nc), sx(nc), sy(nc), sz(nc), sxy(nc), sxz(nc), syz(nc), sxyz(nc);
+
+        const long ox = cstr[0], oy = cstr[1], oz = cstr[2];
+
+        for (int n = 0; n < ncomp; n++)
+        {
+            for (int kc = cell(fblo[2],2); kc <= cell(fbhi[2],2); kc++)
+            for (int jc = cell(fblo[1],1); jc <= cell(fbhi[1],1); jc++)
+            {
+                BL_ASSERT(jc >= clo[1] && kc >= clo[2]);
+
+                const Real* cp = crse.dataPtr(crse_comp) + n*cncomp
+                    + (icl-clo[0]) + cstr[1]*(jc-clo[1]) + cstr[2]*(kc-clo[2]);
+
+                for (int i = 0; i < nc; i++)
+                {
+                    const Real* p = cp + i;
+
+                    const Real dx00 = p[ox] - p[0];
+                    const Real d0x0 = p[oy] - p[0];
+                    const Real d00x = p[oz] - p[0];
+
+                    const Real dx10 = p[ox+oy] - p[oy];
+                    const Real dx01 = p[ox+oz] - p[oz];
+                    const Real d0x1 = p[oy+oz] - p[oz];
+
+                    const Real dx11 = p[ox+oy+oz] - p[oy+oz];
+
+                    c[i]    = p[0];
+                    sx[i]   = RX*dx00;
+                    sy[i]   = RY*d0x0;
+                    sz[i]   = RZ*d00x;
+                    sxy[i]  = RXY*(dx10 - dx00);
+                    sxz[i]  = RXZ*(dx01 - dx00);
+                    syz[i]  = RYZ*(d0x1 - d0x0);
+                    sxyz[i] = RXYZ*(dx11 - dx01 - dx10 + dx00);
+                }
+
+                const int klo = std::max(fblo[2], kc*rr[2]);
+                const int khi = std::min(fbhi[2], kc*rr[2] + ((kc == cend[2]) ? rr[2] : rr[2]-1));
+                const int jlo = std::max(fblo[1], jc*rr[1]);
+                const int jhi = std::min(fbhi[1], jc*rr[1] + ((jc == cend[1]) ? rr[1] : rr[1]-1));
+
+                for (int k = klo; k <= khi; k++)
+                for (int j = jlo; j <= jhi; j++)
+                {
+                    const Real fz = k - kc*rr[2];
+                    const Real fy = j - jc*rr[1];
+
+                    Real* fp = fine.dataPtr(fine_comp) + n*fncomp
+                        + (fblo[0]-flo[0]) + fstr[1]*(j-flo[1]) + fstr[2]*(k-flo[2]);
+
+                    for (int i = 0; i < nf; i++)
+                    {
+                        const int  ic = ics[i];
+                        const Real fx = fxs[i];
+                        fp[i] = c[ic] +
+                            fx*sx[ic] + fy*sy[ic] + fz*sz[ic] +
+                            fx*fy*sxy[ic] + fx*fz*sxz[ic] + fy*fz*syz[ic] +
+                            fx*fy*fz*sxyz[ic];
+                    }
+                }
+            }
+        }
+    }
+
+#if (BL_SPACEDIM < 3)
+    //
+    // Bilinear interpolation of DIM-dimensional cell centered data refined
+    // by R in every direction, or by ratio if R is 0, from the coarse cell
+    // whose center is below and to the left of the fine cell and its
+    // neighbors above.  In 2D this gives the same values as FORT_CBINTERP,
+    // with its operations in the same order; the 1D FORT_CBINTERP puts
+    // every fine cell at the same offset.  The slopes of a row of coarse
+    // cells are found once for all the fine rows they cover, and only
+    // fine_region is filled.
+    //
+    template <int DIM, int R>
+    void
+    cellBilinearInterp (const FArrayBox& crse,
+                        int              crse_comp,
+                        FArrayBox&       fine,
+                        int              fine_comp,
+                        int              ncomp,
+                        const Box&       fine_region,
+                        const IntVect&   ratio)
+    {
+        int rr[2]   = {1,1}, hr[2]  = {0,0};
+        int clo[2]  = {0,0}, chi[2] = {0,0};
+        int fblo[2] = {0,0}, fbhi[2] = {0,0};
+        int flo[2]  = {0,0};
+        for (int d = 0; d < DIM; d++)
+        {
+            rr[d]   = (R > 0) ? R : ratio[d];
+            hr[d]   = rr[d]/2;
+            clo[d]  = crse.box().smallEnd(d);
+            chi[d]  = crse.box().bigEnd(d);
+            fblo[d] = fine_region.smallEnd(d);
+            fbhi[d] = fine_region.bigEnd(d);
+            flo[d]  = fine.box().smallEnd(d);
+        }
+        const int  rx     = (R > 0) ? R : rr[0];
+        const long cstr   = crse.box().length(0);
+        const long fstr   = fine.box().length(0);
+        const long cncomp = crse.box().numPts();
+        const long fncomp = fine.box().numPts();
+        const Real denomx = 1.0/(2*rx);
+        const Real denomy = 1.0/(2*rr[1]);
+        //
+        // The coarse cells with slopes, and the fine index of the low
+        // fine cell of the first of them.
+        //
+        const int nc    = chi[0] - clo[0];
+        const int nf    = fbhi[0] - fblo[0] + 1;
+        const int ibase = clo[0]*rx + hr[0];
+        BL_ASSERT(fblo[0] >= ibase && fbhi[0] - ibase < nc*rx);
+
+        Array<Real> sx(nc), sy(nc), sxy(nc);
+
+        for (int n = 0; n < ncomp; n++)
+        {
+            for (int jc = clo[1]; jc <= ((DIM > 1) ? chi[1]-1 : clo[1]); jc++)
+            {
+                const int jlo = (DIM > 1) ? std::max(fblo[1], jc*rr[1]+hr[1]) : 0;
+                const int jhi = (DIM > 1) ? std::min(fbhi[1], jc*rr[1]+hr[1]+rr[1]-1) : 0;
+
+                if (jlo > jhi) continue;
+
+                const Real* cp = crse.dataPtr(crse_comp) + n*cncomp + cstr*(jc-clo[1]);
+
+                for (int i = 0; i < nc; i++)
+                {
+                    sx[i] = cp[i+1] - cp[i];
+                    if (DIM > 1)
+                    {
+                        sy[i]  = cp[i+cstr] - cp[i];
+                        sxy[i] = cp[i+1+cstr] - cp[i+1] - cp[i+cstr] + cp[i];
+                    }
+                }
+
+                for (int j = jlo; j <= jhi; j++)
+                {
+                    const Real y  = (DIM > 1) ? denomy*(2.0*(j-hr[1]-jc*rr[1]) + 1.0) : 0.0;
+                    Real*      fp = fine.dataPtr(fine_comp) + n*fncomp
+                        + (fblo[0]-flo[0]) + fstr*(j-flo[1]);
+
+                    for (int i = 0; i < nf; i++)
+                    {
+                        const int  ii = fblo[0] + i - ibase;
+                        const int  ic = ii/rx;
+                        const Real x  = denomx*(2.0*(ii - ic*rx) + 1.0);
+                        Real       v  = cp[ic] + x*sx[ic];
+                        if (DIM > 1)
+                        {
+                            v += y*sy[ic];
+                            v += x*y*sxy[ic];
+                        }
+                        fp[i] = v;
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    cellBilinearInterp (const FArrayBox& crse,
+                        int              crse_comp,
+                        FArrayBox&       fine,
+                        int              fine_comp,
+                        int              ncomp,
+                        const Box&       fine_region,
+                        const IntVect&   ratio)
+    {
+        if (ratio == 2*IntVect::TheUnitVector())
+        {
+            cellBilinearInterp<BL_SPACEDIM,2>(crse, crse_comp, fine, fine_comp, ncomp,
+                                              fine_region, ratio);
+        }
+        else if (ratio == 4*IntVect::TheUnitVector())
+        {
+            cellBilinearInterp<BL_SPACEDIM,4>(crse, crse_comp, fine, fine_comp, ncomp,
+                                              fine_region, ratio);
+        }
+        else
+        {
+            cellBilinearInterp<BL_SPACEDIM,0>(crse, crse_comp, fine, fine_comp, ncomp,
+                                              fine_region, ratio);
+        }
+    }
+#endif
+}
+
 void
 NodeBilinear::interp (const FArrayBox&  crse,
                       int               crse_comp,
@@ -102,6 +386,12 @@ NodeBilinear::interp (const FArrayBox&  crse,
                       int               actual_state)
 {
     BL_PROFILE("NodeBilinear::interp()");
+
+    if (!UseFortran())
+    {
+        nodeBilinearInterp(crse, crse_comp, fine, fine_comp, ncomp, fine_region, ratio);
+        return;
+    }
     //
     // Set up to call FORTRAN.
     //
@@ -176,6 +466,12 @@ CellBilinear::interp (const FArrayBox&  crse,
     BL_PROFILE("CellBilinear::interp()");
 #if (BL_SPACEDIM == 3)
     amrex::Error("interp: not implemented");
+#else
+    if (!UseFortran())
+    {
+        cellBilinearInterp(crse, crse_comp, fine, fine_comp, ncomp, fine_region, ratio);
+        return;
+    }
 #endif
     //
     // Set up to call FORTRAN.
@@ -228,6 +524,614 @@ Interpolater::GetBCArray (const Array<BCRec>& bcr)
     return bc;
 }
 
+namespace
+{
+    //
+    // Offsets of the fine cell centers from their coarse cell centers
+    // in units of the coarse cell size, from the edge volume
+    // coordinates, for the fine cells over cslope_bx.
+    //
+    void
+    cellOffsets (const Array<Real>* fvc,
+                 const Array<Real>* cvc,
+                 const Box&         cslope_bx,
+                 const Box&         crse_bx,
+                 const IntVect&     ratio,
+                 Array<Real>*       voff)
+    {
+        for (int dir = 0; dir < BL_SPACEDIM; dir++)
+        {
+            const int vlo = cslope_bx.smallEnd(dir) * ratio[dir];
+            const int vhi = (cslope_bx.bigEnd(dir)+1) * ratio[dir] - 1;
+            const int clo = crse_bx.smallEnd(dir);
+
+            voff[dir].resize(vhi - vlo + 1);
+
+            for (int i = vlo; i <= vhi; i++)
+            {
+                const int  ic   = crseIndex(i,ratio[dir]) - clo;
+                const Real fcen = 0.5*(fvc[dir][i-vlo]+fvc[dir][i-vlo+1]);
+                const Real ccen = 0.5*(cvc[dir][ic]+cvc[dir][ic+1]);
+                voff[dir][i-vlo] = (fcen-ccen)/(cvc[dir][ic+1]-cvc[dir][ic]);
+            }
+        }
+    }
+
+    //
+    // The slope limited so it makes no new extrema with the neighbors.
+    //
+    inline Real
+    limitedSlope (Real uc, Real cm, Real c0, Real cp)
+    {
+        const Real forw = 2.0*(cp-c0);
+        const Real back = 2.0*(c0-cm);
+        Real slp = std::min(std::abs(forw),std::abs(back));
+        slp = (forw*back >= 0.0) ? slp : 0.0;
+        return std::copysign(Real(1.0),uc)*std::min(slp,std::abs(uc));
+    }
+
+    //
+    // The one-sided slope at a low (lo true) or high EXT_DIR or HOEXTRAP
+    // boundary, from the values at offsets -2..2 from the cell; far
+    // says there are two cells inside to use.
+    //
+    inline Real
+    boundarySlope (bool lo, bool far, Real cm2, Real cm, Real c0, Real cp, Real cp2)
+    {
+        const Real sixteen15 = 16.0/15.0;
+        const Real two3rd    = 0.66666666666666667;
+
+        if (lo)
+            return far ? -(sixteen15*cm) + 0.5*c0 + two3rd*cp - 0.1*cp2
+                       : 0.25*(cp + 5.0*c0 - 6.0*cm);
+        else
+            return far ? sixteen15*cp - 0.5*c0 - two3rd*cm + 0.1*cm2
+                       : -(0.25*(cm + 5.0*c0 - 6.0*cp));
+    }
+
+    inline bool
+    oneSided (int bc)
+    {
+        return bc == BCType::ext_dir || bc == BCType::hoextrap;
+    }
+
+    //
+    // Conservative linear interpolation of DIM-dimensional data refined
+    // by R in every direction, or by ratio if R is 0.  This gives the
+    // same values as FORT_LINCCINTERP, but works one row of coarse cells
+    // at a time: the slopes, their limiting and the limiter factors of
+    // the row are found in one sweep over it and the fine rows it covers
+    // are filled right after, so nothing the size of the box is stored.
+    // The inner loops are over the cells of the row and have no branches
+    // for the compiler to vectorize them.
+    //
+    template <int DIM, int R>
+    void
+    linccInterp (const FArrayBox& crse,
+                 int              crse_comp,
+                 FArrayBox&       fine,
+                 int              fine_comp,
+                 int              ncomp,
+                 const Box&       fine_region,
+                 const Box&       cslope_bx,
+                 const IntVect&   ratio,
+                 const Array<Real>* voff,
+                 const Array<int>&  bc,
+                 bool             lin_limit)
+    {
+        //
+        // Everything is indexed in three dimensions, with the unused
+        // ones of length one.
+        //
+        int rr[3]   = {1,1,1};
+        int cslo[3] = {0,0,0}, cshi[3] = {0,0,0};
+        int fblo[3] = {0,0,0}, fbhi[3] = {0,0,0};
+        int clo[3]  = {0,0,0}, clen[3] = {1,1,1};
+        int flo[3]  = {0,0,0}, flen[3] = {1,1,1};
+        for (int d = 0; d < DIM; d++)
+        {
+            rr[d]   = (R > 0) ? R : ratio[d];
+            cslo[d] = cslope_bx.smallEnd(d);
+            cshi[d] = cslope_bx.bigEnd(d);
+            fblo[d] = fine_region.smallEnd(d);
+            fbhi[d] = fine_region.bigEnd(d);
+            clo[d]  = crse.box().smallEnd(d);
+            clen[d] = crse.box().length(d);
+            flo[d]  = fine.box().smallEnd(d);
+            flen[d] = fine.box().length(d);
+        }
+        const int  rx     = (R > 0) ? R : rr[0];
+        const long cstr[3] = { 1, clen[0], long(clen[0])*clen[1] };
+        const long fstr[3] = { 1, flen[0], long(flen[0])*flen[1] };
+        const long cncomp  = cstr[2]*clen[2];
+        const long fncomp  = fstr[2]*flen[2];
+        const int  nx      = cshi[0]-cslo[0]+1;
+
+        bool far[3];
+        for (int d = 0; d < 3; d++)
+            far[d] = (cshi[d]-cslo[d]+1 >= 2);
+        //
+        // The offsets of the fine cells, by fine index.
+        //
+        const Real* vo[3] = {0,0,0};
+        for (int d = 0; d < DIM; d++)
+            vo[d] = voff[d].dataPtr() - cslo[d]*rr[d];
+        //
+        // The row's unlimited and limited slopes, (n*DIM+d)*nx + ic,
+        // the factors, d*nx + ic, and the limiters, n*nx + ic.
+        //
+        Array<Real> ucs(ncomp*DIM*nx), lcs(ncomp*DIM*nx);
+        Array<Real> fac(DIM*nx), alpha(ncomp*nx), cmax(nx), cmin(nx);
+
+        for (int kc = cslo[2]; kc <= cshi[2]; kc++)
+        for (int jc = cslo[1]; jc <= cshi[1]; jc++)
+        {
+            const int jkc[3] = {0, jc, kc};
+
+            for (int n = 0; n < ncomp; n++)
+            {
+                const Real* cp = crse.dataPtr(crse_comp) + n*cncomp
+                    + (cslo[0]-clo[0]) + cstr[1]*(jc-clo[1]) + cstr[2]*(kc-clo[2]);
+                const int*  bn = &bc[2*BL_SPACEDIM*n];
+
+                for (int d = 0; d < DIM; d++)
+                {
+                    const long s  = cstr[d];
+                    Real*      uc = &ucs[(n*DIM+d)*nx];
+                    Real*      lc = &lcs[(n*DIM+d)*nx];
+
+                    for (int i = 0; i < nx; i++)
+                        uc[i] = 0.5*(cp[i+s]-cp[i-s]);
+
+                    if (d == 0)
+                    {
+                        if (oneSided(bn[0]))
+                            uc[0] = boundarySlope(true, far[0], 0.0, cp[-1], cp[0], cp[1],
+                                                  far[0] ? cp[2] : 0.0);
+                        if (oneSided(bn[BL_SPACEDIM]))
+                            uc[nx-1] = boundarySlope(false, far[0], far[0] ? cp[nx-3] : 0.0,
+                                                     cp[nx-2], cp[nx-1], cp[nx], 0.0);
+                    }
+                    else
+                    {
+                        const bool lo = oneSided(bn[d]) && jkc[d] == cslo[d];
+                        const bool hi = oneSided(bn[BL_SPACEDIM+d]) && jkc[d] == cshi[d];
+                        if (hi)
+                        {
+                            for (int i = 0; i < nx; i++)
+                                uc[i] = boundarySlope(false, far[d], far[d] ? cp[i-2*s] : 0.0,
+                                                      cp[i-s], cp[i], cp[i+s], 0.0);
+                        }
+                        else if (lo)
+                        {
+                            for (int i = 0; i < nx; i++)
+                                uc[i] = boundarySlope(true, far[d], 0.0, cp[i-s], cp[i], cp[i+s],
+                                                      far[d] ? cp[i+2*s] : 0.0);
+                        }
+                    }
+
+                    for (int i = 0; i < nx; i++)
+                        lc[i] = limitedSlope(uc[i], cp[i-s], cp[i], cp[i+s]);
+                }
+            }
+
+            if (lin_limit)
+            {
+                //
+                // One factor per direction for all the components.
+                //
+                for (int d = 0; d < DIM; d++)
+                {
+                    Real* f = &fac[d*nx];
+                    for (int i = 0; i < nx; i++)
+                        f[i] = 1.0;
+                    for (int n = 0; n < ncomp; n++)
+                    {
+                        const Real* uc = &ucs[(n*DIM+d)*nx];
+                        const Real* lc = &lcs[(n*DIM+d)*nx];
+                        for (int i = 0; i < nx; i++)
+                        {
+                            const Real den = (uc[i] != 0.0) ? uc[i] : 1.0;
+                            f[i] = std::min(f[i], (uc[i] != 0.0) ? lc[i]/den : 1.0);
+                        }
+                    }
+                }
+                for (int n = 0; n < ncomp; n++)
+                {
+                    for (int d = 0; d < DIM; d++)
+                    {
+                        const Real* f  = &fac[d*nx];
+                        const Real* uc = &ucs[(n*DIM+d)*nx];
+                        Real*       lc = &lcs[(n*DIM+d)*nx];
+                        for (int i = 0; i < nx; i++)
+                            lc[i] = f[i]*uc[i];
+                    }
+                    for (int i = 0; i < nx; i++)
+                        alpha[n*nx+i] = 1.0;
+                }
+            }
+            else
+            {
+                //
+                // Limit so the fine cells have no new extrema in the
+                // coarse neighborhood.
+                //
+                for (int n = 0; n < ncomp; n++)
+                {
+                    const Real* cp = crse.dataPtr(crse_comp) + n*cncomp
+                        + (cslo[0]-clo[0]) + cstr[1]*(jc-clo[1]) + cstr[2]*(kc-clo[2]);
+
+                    for (int i = 0; i < nx; i++)
+                        cmax[i] = cmin[i] = cp[i];
+
+                    for (int koff = (DIM>2 ? -1 : 0); koff <= (DIM>2 ? 1 : 0); koff++)
+                    for (int joff = (DIM>1 ? -1 : 0); joff <= (DIM>1 ? 1 : 0); joff++)
+                    {
+                        const Real* q = cp + cstr[1]*joff + cstr[2]*koff;
+                        for (int i = 0; i < nx; i++)
+                        {
+                            cmax[i] = std::max(cmax[i], std::max(std::max(q[i-1],q[i]),q[i+1]));
+                            cmin[i] = std::min(cmin[i], std::min(std::min(q[i-1],q[i]),q[i+1]));
+                        }
+                    }
+
+                    const Real* lx = &lcs[(n*DIM)*nx];
+                    const Real* ly = (DIM > 1) ? &lcs[(n*DIM+1)*nx] : lx;
+                    const Real* lz = (DIM > 2) ? &lcs[(n*DIM+2)*nx] : lx;
+                    Real*       a  = &alpha[n*nx];
+
+                    for (int i = 0; i < nx; i++)
+                        a[i] = 1.0;
+
+                    for (int k = kc*rr[2]; k < (kc+1)*rr[2]; k++)
+                    for (int j = jc*rr[1]; j < (jc+1)*rr[1]; j++)
+                    {
+                        const Real vy = (DIM > 1) ? vo[1][j] : 0.0;
+                        const Real vz = (DIM > 2) ? vo[2][k] : 0.0;
+
+                        for (int ii = 0; ii < rx; ii++)
+                        {
+                            const Real* vx = vo[0] + cslo[0]*rx + ii;
+
+                            for (int i = 0; i < nx; i++)
+                            {
+                                Real corr = vx[i*rx]*lx[i];
+                                if (DIM > 1) corr += vy*ly[i];
+                                if (DIM > 2) corr += vz*lz[i];
+                                const Real f   = cp[i] + corr;
+                                const bool fix = (f > cmax[i] || f < cmin[i])
+                                    && std::abs(corr) > 1.e-10*std::abs(cp[i]);
+                                const Real lim = (f > cmax[i]) ? cmax[i] : cmin[i];
+                                const Real den = fix ? corr : 1.0;
+                                a[i] = std::min(a[i], fix ? (lim-cp[i])/den : 1.0);
+                            }
+                        }
+                    }
+                }
+            }
+            //
+            // Fill the fine cells of the row that are in the region.
+            //
+            const int klo = (DIM > 2) ? std::max(fblo[2], kc*rr[2]) : 0;
+            const int khi = (DIM > 2) ? std::min(fbhi[2], kc*rr[2]+rr[2]-1) : 0;
+            const int jlo = (DIM > 1) ? std::max(fblo[1], jc*rr[1]) : 0;
+            const int jhi = (DIM > 1) ? std::min(fbhi[1], jc*rr[1]+rr[1]-1) : 0;
+            //
+            // The coarse cells, relative to the row, whose fine cells are
+            // all in the region, and the fine cells of the others.
+            //
+            const int ilo   = fblo[0] - cslo[0]*rx;
+            const int ihi   = fbhi[0] - cslo[0]*rx;
+            const int icful = (ilo + rx - 1)/rx;
+            const int ichul = (ihi + 1)/rx - 1;
+
+            for (int n = 0; n < ncomp; n++)
+            {
+                const Real* cp = crse.dataPtr(crse_comp) + n*cncomp
+                    + (cslo[0]-clo[0]) + cstr[1]*(jc-clo[1]) + cstr[2]*(kc-clo[2]);
+                const Real* lx = &lcs[(n*DIM)*nx];
+                const Real* ly = (DIM > 1) ? &lcs[(n*DIM+1)*nx] : lx;
+                const Real* lz = (DIM > 2) ? &lcs[(n*DIM+2)*nx] : lx;
+                const Real* a  = &alpha[n*nx];
+                const Real* vx = vo[0] + cslo[0]*rx;
+
+                for (int k = klo; k <= khi; k++)
+                for (int j = jlo; j <= jhi; j++)
+                {
+                    const Real vy = (DIM > 1) ? vo[1][j] : 0.0;
+                    const Real vz = (DIM > 2) ? vo[2][k] : 0.0;
+                    Real* frow    = fine.dataPtr(fine_comp) + n*fncomp
+                        + (cslo[0]*rx-flo[0]) + fstr[1]*(j-flo[1]) + fstr[2]*(k-flo[2]);
+
+                    for (int ic = icful; ic <= ichul; ic++)
+                    {
+                        for (int ii = 0; ii < rx; ii++)
+                        {
+                            const int i = ic*rx + ii;
+                            Real corr = vx[i]*lx[ic];
+                            if (DIM > 1) corr += vy*ly[ic];
+                            if (DIM > 2) corr += vz*lz[ic];
+                            frow[i] = cp[ic] + a[ic]*corr;
+                        }
+                    }
+
+                    const int ib[2] = { ilo, std::max(ilo, std::max(icful, ichul+1)*rx) };
+                    const int ie[2] = { std::min(ihi, icful*rx-1), ihi };
+
+                    for (int p = 0; p < 2; p++)
+                    for (int i = ib[p]; i <= ie[p]; i++)
+                    {
+                        const int ic = i/rx;
+                        Real corr = vx[i]*lx[ic];
+                        if (DIM > 1) corr += vy*ly[ic];
+                        if (DIM > 2) corr += vz*lz[ic];
+                        frow[i] = cp[ic] + a[ic]*corr;
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    linccInterp (const FArrayBox& crse,
+                 int              crse_comp,
+                 FArrayBox&       fine,
+                 int              fine_comp,
+                 int              ncomp,
+                 const Box&       fine_region,
+                 const Box&       cslope_bx,
+                 const IntVect&   ratio,
+                 const Array<Real>* voff,
+                 const Array<int>&  bc,
+                 bool             lin_limit)
+    {
+        if (ratio == 2*IntVect::TheUnitVector())
+        {
+            linccInterp<BL_SPACEDIM,2>(crse, crse_comp, fine, fine_comp, ncomp, fine_region,
+                                       cslope_bx, ratio, voff, bc, lin_limit);
+        }
+        else if (ratio == 4*IntVect::TheUnitVector())
+        {
+            linccInterp<BL_SPACEDIM,4>(crse, crse_comp, fine, fine_comp, ncomp, fine_region,
+                                       cslope_bx, ratio, voff, bc, lin_limit);
+        }
+        else
+        {
+            linccInterp<BL_SPACEDIM,0>(crse, crse_comp, fine, fine_comp, ncomp, fine_region,
+                                       cslope_bx, ratio, voff, bc, lin_limit);
+        }
+    }
+
+#if (BL_SPACEDIM < 3)
+    inline Real
+    flushTiny (Real v)
+    {
+        return (std::abs(v) > 1.e-50) ? v : 0.0;
+    }
+
+    //
+    // Quadratic interpolation of DIM-dimensional cell centered data
+    // refined by R in every direction, or by ratio if R is 0, from the
+    // first and second differences of the coarse data, one-sided in the
+    // normal direction at EXT_DIR and HOEXTRAP boundaries.  In 2D this
+    // gives the same values as FORT_CQINTERP, with its operations in the
+    // same order, but finds the slopes one row of coarse cells at a time
+    // and does not flush the tiny values of crse to zero in place.  There
+    // is no 1D FORT_CQINTERP.
+    //
+    template <int DIM, int R>
+    void
+    cellQuadraticInterp (const FArrayBox&   crse,
+                         int                crse_comp,
+                         FArrayBox&         fine,
+                         int                fine_comp,
+                         int                ncomp,
+                         const Box&         fine_region,
+                         const Box&         crse_bx,
+                         const IntVect&     ratio,
+                         const Array<Real>* fvc,
+                         const Array<Real>* cvc,
+                         const Array<int>&  bc)
+    {
+        int rr[2]   = {1,1};
+        int cblo[2] = {0,0}, cbhi[2] = {0,0};
+        int fblo[2] = {0,0}, fbhi[2] = {0,0};
+        int clo[2]  = {0,0}, flo[2]  = {0,0};
+        for (int d = 0; d < DIM; d++)
+        {
+            rr[d]   = (R > 0) ? R : ratio[d];
+            cblo[d] = crse_bx.smallEnd(d);
+            cbhi[d] = crse_bx.bigEnd(d);
+            fblo[d] = fine_region.smallEnd(d);
+            fbhi[d] = fine_region.bigEnd(d);
+            clo[d]  = crse.box().smallEnd(d);
+            flo[d]  = fine.box().smallEnd(d);
+        }
+        const int  rx     = (R > 0) ? R : rr[0];
+        const long s      = (DIM > 1) ? crse.box().length(0) : 0;
+        const long fstr   = fine.box().length(0);
+        const long cncomp = crse.box().numPts();
+        const long fncomp = fine.box().numPts();
+        const int  ncbx   = cbhi[0] - cblo[0] + 1;
+        const bool xok    = (ncbx >= 2);
+        const bool yok    = (cbhi[1] - cblo[1] + 1 >= 2);
+        const int  nf     = fbhi[0] - fblo[0] + 1;
+        const int  ibase  = cblo[0]*rx;
+        //
+        // The offsets of the fine cells of a row from their coarse cell
+        // centers, in units of the coarse cell size.
+        //
+        Array<Real> xoff(nf);
+        for (int i = fblo[0]; i <= fbhi[0]; i++)
+        {
+            const int  ic   = crseIndex(i,rx) - cblo[0];
+            const Real fcen = 0.5*(fvc[0][i-fblo[0]]+fvc[0][i-fblo[0]+1]);
+            const Real ccen = 0.5*(cvc[0][ic]+cvc[0][ic+1]);
+            xoff[i-fblo[0]] = (fcen-ccen)/(cvc[0][ic+1]-cvc[0][ic]);
+        }
+        //
+        // The row's values and its slopes: the first and second
+        // differences in x, then in y, then the cross difference.
+        //
+        Array<Real> c0(ncbx), s1(ncbx), s2(ncbx), s3(ncbx), s4(ncbx), s5(ncbx);
+
+        for (int n = 0; n < ncomp; n++)
+        {
+            const int* bn = &bc[2*BL_SPACEDIM*n];
+
+            for (int jc = cblo[1]; jc <= cbhi[1]; jc++)
+            {
+                const Real* cp = crse.dataPtr(crse_comp) + n*cncomp
+                    + (cblo[0]-clo[0]) + s*(jc-clo[1]);
+
+                for (int i = 0; i < ncbx; i++)
+                {
+                    const Real* p  = cp + i;
+                    const Real  cm = flushTiny(p[-1]);
+                    const Real  c  = flushTiny(p[0]);
+                    const Real  cq = flushTiny(p[1]);
+                    c0[i] = c;
+                    s1[i] = 0.5*(cq-cm);
+                    s3[i] = cq - 2.0*c + cm;
+                    if (DIM > 1)
+                    {
+                        const Real ym = flushTiny(p[-s]);
+                        const Real yp = flushTiny(p[s]);
+                        s2[i] = 0.5*(yp-ym);
+                        s4[i] = yp - 2.0*c + ym;
+                        s5[i] = 0.25*(flushTiny(p[1+s]) + flushTiny(p[-1-s])
+                                      - flushTiny(p[-1+s]) - flushTiny(p[1-s]));
+                    }
+                }
+
+                if (xok && oneSided(bn[0]))
+                {
+                    s1[0] = boundarySlope(true, true, 0.0, flushTiny(cp[-1]), c0[0],
+                                          c0[1], flushTiny(cp[2]));
+                    s3[0] = 0.0;
+                    s5[0] = 0.0;
+                }
+                if (xok && oneSided(bn[BL_SPACEDIM]))
+                {
+                    const int i = ncbx-1;
+                    s1[i] = boundarySlope(false, true, flushTiny(cp[i-2]), c0[i-1], c0[i],
+                                          flushTiny(cp[i+1]), 0.0);
+                    s3[i] = 0.0;
+                    s5[i] = 0.0;
+                }
+                if (DIM > 1 && yok)
+                {
+                    const bool lo = oneSided(bn[1]) && jc == cblo[1];
+                    const bool hi = oneSided(bn[BL_SPACEDIM+1]) && jc == cbhi[1];
+                    if (lo || hi)
+                    {
+                        for (int i = 0; i < ncbx; i++)
+                        {
+                            const Real* p = cp + i;
+                            s2[i] = lo
+                                ? boundarySlope(true, true, 0.0, flushTiny(p[-s]), c0[i],
+                                                flushTiny(p[s]), flushTiny(p[2*s]))
+                                : boundarySlope(false, true, flushTiny(p[-2*s]), flushTiny(p[-s]),
+                                                c0[i], flushTiny(p[s]), 0.0);
+                            s4[i] = 0.0;
+                            s5[i] = 0.0;
+                        }
+                    }
+                }
+                //
+                // Fill the fine cells of the row that are in the region.
+                //
+                const int jlo = (DIM > 1) ? std::max(fblo[1], jc*rr[1]) : 0;
+                const int jhi = (DIM > 1) ? std::min(fbhi[1], jc*rr[1]+rr[1]-1) : 0;
+
+                for (int j = jlo; j <= jhi; j++)
+                {
+                    Real yoff = 0.0;
+                    if (DIM > 1)
+                    {
+                        const int  jr   = jc - cblo[1];
+                        const Real fcen = 0.5*(fvc[1][j-fblo[1]]+fvc[1][j-fblo[1]+1]);
+                        const Real ccen = 0.5*(cvc[1][jr]+cvc[1][jr+1]);
+                        yoff = (fcen-ccen)/(cvc[1][jr+1]-cvc[1][jr]);
+                    }
+                    Real* fp = fine.dataPtr(fine_comp) + n*fncomp
+                        + (fblo[0]-flo[0]) + fstr*(j-flo[1]);
+
+                    for (int i = 0; i < nf; i++)
+                    {
+                        const int  ic = (fblo[0] + i - ibase)/rx;
+                        const Real x  = xoff[i];
+                        Real       v  = c0[ic] + x*s1[ic];
+                        if (DIM > 1)
+                            v += yoff*s2[ic];
+                        v += 0.5*x*x*s3[ic];
+                        if (DIM > 1)
+                        {
+                            v += 0.5*yoff*yoff*s4[ic];
+                            v += x*yoff*s5[ic];
+                        }
+                        fp[i] = v;
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    cellQuadraticInterp (const FArrayBox&   crse,
+                         int                crse_comp,
+                         FArrayBox&         fine,
+                         int                fine_comp,
+                         int                ncomp,
+                         const Box&         fine_region,
+                         const Box&         crse_bx,
+                         const IntVect&     ratio,
+                         const Array<Real>* fvc,
+                         const Array<Real>* cvc,
+                         const Array<int>&  bc)
+    {
+        if (ratio == 2*IntVect::TheUnitVector())
+        {
+            cellQuadraticInterp<BL_SPACEDIM,2>(crse, crse_comp, fine, fine_comp, ncomp,
+                                               fine_region, crse_bx, ratio, fvc, cvc, bc);
+        }
+        else if (ratio == 4*IntVect::TheUnitVector())
+        {
+            cellQuadraticInterp<BL_SPACEDIM,4>(crse, crse_comp, fine, fine_comp, ncomp,
+                                               fine_region, crse_bx, ratio, fvc, cvc, bc);
+        }
+        else
+        {
+            cellQuadraticInterp<BL_SPACEDIM,0>(crse, crse_comp, fine, fine_comp, ncomp,
+                                               fine_region, crse_bx, ratio, fvc, cvc, bc);
+        }
+    }
+#endif
+}
+
+bool
+Interpolater::UseFortran ()
+{
+    //
+    // Called from within OpenMP regions, so ParmParse is read by the
+    // thread-safe initialization of a local static, once.
+    //
+    static const bool pp_use_fortran = [] () {
+        int use_fortran = 0;
+        ParmParse pp("interp");
+        pp.query("use_fortran", use_fortran);
+        return use_fortran > 0;
+    }();
+
+    return use_fortran_kernels < 0 ? pp_use_fortran : use_fortran_kernels > 0;
+}
+
+void
+Interpolater::SetUseFortran (bool use_fortran)
+{
+    use_fortran_kernels = use_fortran;
+}
+
 CellConservativeLinear::CellConservativeLinear (bool do_linear_limiting_)
 {
     do_linear_limiting = do_linear_limiting_;
@@ -299,6 +1203,15 @@ CellConservativeLinear::interp (const FArrayBox& crse,
         fine_geom.GetEdgeVolCoord(fvc[dir],fine_version_of_cslope_bx,dir);
         crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
     }
+
+    if (!UseFortran())
+    {
+        Array<Real> voff[BL_SPACEDIM];
+        cellOffsets(fvc, cvc, cslope_bx, crse_bx, ratio, voff);
+        linccInterp(crse, crse_comp, fine, fine_comp, ncomp, target_fine_region,
+                    cslope_bx, ratio, voff, GetBCArray(bcr), do_linear_limiting);
+        return;
+    }
     //
     // alloc tmp space for slope calc.
     //
@@ -437,6 +1350,27 @@ CellQuadratic::interp (const FArrayBox& crse,
     Box cslope_bx(crse_bx);
     cslope_bx.grow(1);
     BL_ASSERT(crse.box().contains(cslope_bx));
+    //
+    // Get coarse and fine edge-centered volume coordinates.
+    //
+    int dir;
+    Array<Real> fvc[BL_SPACEDIM];
+    Array<Real> cvc[BL_SPACEDIM];
+    for (dir = 0; dir < BL_SPACEDIM; dir++)
+    {
+        fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
+        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
+    }
+    Array<int> bc     = GetBCArray(bcr);
+
+#if (BL_SPACEDIM < 3)
+    if (!UseFortran())
+    {
+        cellQuadraticInterp(crse, crse_comp, fine, fine_comp, ncomp, target_fine_region,
+                            crse_bx, ratio, fvc, cvc, bc);
+        return;
+    }
+#endif
     //
     // Alloc temp space for coarse grid slopes: here we use 5 
     // instead of BL_SPACEDIM because of the x^2, y^2 and xy terms
@@ -460,7 +1394,6 @@ CellQuadratic::interp (const FArrayBox& crse,
     // Alloc temp space for one strip of fine grid slopes: here we use 5 
     // instead of BL_SPACEDIM because of the x^2, y^2 and xy terms.
     //
-    int dir;
     int f_len = fslope_bx.longside(dir);
 
     Array<Real> strip((5+2)*f_len);
@@ -469,16 +1402,6 @@ CellQuadratic::interp (const FArrayBox& crse,
     Real* foff   = fstrip + f_len;
     Real* fslope = foff + f_len;
     //
-    // Get coarse and fine edge-centered volume coordinates.
-    //
-    Array<Real> fvc[BL_SPACEDIM];
-    Array<Real> cvc[BL_SPACEDIM];
-    for (dir = 0; dir < BL_SPACEDIM; dir++)
-    {
-        fine_geom.GetEdgeVolCoord(fvc[dir],target_fine_region,dir);
-        crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
-    }
-    //
     // Alloc tmp space for slope calc and to allow for vectorization.
     //
     Real* fdat        = fine.dataPtr(fine_comp);
@@ -492,7 +1415,6 @@ CellQuadratic::interp (const FArrayBox& crse,
     const int* fslo   = fslope_bx.loVect();
     const int* fshi   = fslope_bx.hiVect();
     int slope_flag    = (do_limited_slope ? 1 : 0);
-    Array<int> bc     = GetBCArray(bcr);
     const int* ratioV = ratio.getVect();
 
 #if (BL_SPACEDIM > 1)
@@ -647,6 +1569,17 @@ CellConservativeProtected::interp (const FArrayBox& crse,
         fine_geom.GetEdgeVolCoord(fvc[dir],fine_version_of_cslope_bx,dir);
         crse_geom.GetEdgeVolCoord(cvc[dir],crse_bx,dir);
     }
+
+#if (BL_SPACEDIM > 1)
+    if (!UseFortran())
+    {
+        Array<Real> voff[BL_SPACEDIM];
+        cellOffsets(fvc, cvc, cslope_bx, crse_bx, ratio, voff);
+        linccInterp(crse, crse_comp, fine, fine_comp, ncomp, target_fine_region,
+                    cslope_bx, ratio, voff, GetBCArray(bcr), true);
+        return;
+    }
+#endif
     //
     // alloc tmp space for slope calc.
     //
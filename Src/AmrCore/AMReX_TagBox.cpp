@@ -258,6 +258,48 @@ TagBox::collate (std::vector<IntVect>& ar, int start) const
     return count;
 }
 
+long
+TagBox::collate (std::vector<TagRun>& runs) const
+{
+    //
+    // Enter the runs of tagged cells of each row of the tagbox.
+    //
+    long count       = 0;
+    IntVect d_length = domain.size();
+    const int* len   = d_length.getVect();
+    const int* lo    = domain.loVect();
+    const TagType* d = dataPtr();
+    int ni = 1, nj = 1, nk = 1;
+    AMREX_D_TERM(ni = len[0]; , nj = len[1]; , nk = len[2];)
+
+    for (int k = 0; k < nk; k++)
+    {
+        for (int j = 0; j < nj; j++)
+        {
+            const TagType* dn = d + AMREX_D_TERM(0, +j*len[0], +k*len[0]*len[1]);
+
+            for (int i = 0; i < ni; )
+            {
+                if (dn[i] == TagBox::CLEAR)
+                {
+                    i++;
+                    continue;
+                }
+                const int i0 = i;
+                while (i < ni && dn[i] != TagBox::CLEAR)
+                    i++;
+
+                TagRun r;
+                r.start = IntVect(AMREX_D_DECL(lo[0]+i0,lo[1]+j,lo[2]+k));
+                r.len   = i - i0;
+                runs.push_back(r);
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
 Array<int>
 TagBox::tags () const
 {
@@ -599,6 +641,129 @@ TagBoxArray::collate (std::vector<IntVect>& TheGlobalCollateSpace) const
 #endif
 }
 
+void
+TagBoxArray::collate (std::vector<TagRun>& TheGlobalRuns) const
+{
+    BL_PROFILE("TagBoxArray::collate(runs)");
+
+    std::vector<TagRun> TheLocalRuns;
+
+    // unsafe to do OMP
+    for (MFIter fai(*this); fai.isValid(); ++fai)
+    {
+        get(fai).collate(TheLocalRuns);
+    }
+    //
+    // Remove the duplicates of overlapping TagBoxes on this processor.
+    //
+    mergeTagRuns(TheLocalRuns);
+
+    long count = TheLocalRuns.size();
+    //
+    // An upper bound on the number of runs system wide, since those of
+    // different processors may still overlap.
+    //
+    long numruns = count;
+
+    ParallelDescriptor::ReduceLongSum(numruns);
+
+    if (numruns == 0) {
+        TheGlobalRuns.clear();
+        return;
+    }
+
+#if BL_USE_MPI
+    TheGlobalRuns.resize(numruns);
+    //
+    // Tell root CPU how many runs each CPU will be sending.
+    //
+    const int IOProcNumber = ParallelDescriptor::IOProcessorNumber();
+    const int nints = BL_SPACEDIM + 1;
+    count *= nints;  // Convert from count of runs to count of integers to expect.
+    const std::vector<long>& countvec = ParallelDescriptor::Gather(count, IOProcNumber);
+
+    std::vector<long> offset(countvec.size(),0L);
+    if (ParallelDescriptor::IOProcessor())
+    {
+        for (int i = 1, N = offset.size(); i < N; i++) {
+            offset[i] = offset[i-1] + countvec[i-1];
+        }
+    }
+    //
+    // Gather all the runs to IOProcNumber into TheGlobalRuns.
+    //
+    BL_ASSERT(sizeof(TagRun) == nints * sizeof(int));
+    const int* psend = (count > 0) ? TheLocalRuns[0].start.getVect() : 0;
+    int* precv = TheGlobalRuns[0].start.getVect();
+    ParallelDescriptor::Gatherv(psend, count,
+                                precv, countvec, offset, IOProcNumber);
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        //
+        // Remove the duplicates between processors.
+        //
+        mergeTagRuns(TheGlobalRuns);
+        numruns = TheGlobalRuns.size();
+    }
+    //
+    // Now broadcast them back to the other processors.
+    //
+    ParallelDescriptor::Bcast(&numruns, 1, IOProcNumber);
+    TheGlobalRuns.resize(numruns);
+    ParallelDescriptor::Bcast(TheGlobalRuns[0].start.getVect(), numruns*nints, IOProcNumber);
+#else
+    TheGlobalRuns.swap(TheLocalRuns);
+#endif
+}
+
+void
+TagBoxArray::collateLocal (std::vector<TagRun>& TheLocalRuns) const
+{
+    BL_PROFILE("TagBoxArray::collateLocal()");
+
+    BL_ASSERT(n_grow == 0);
+
+    //
+    // Each box of the disjoint layout is a piece of a box of this one
+    // and goes to the processor owning that box, so only the tags in
+    // overlaps move.
+    //
+    BoxArray dba(boxArray().boxList());
+    dba.removeOverlap(false);
+
+    Array<int> pmap(dba.size());
+    std::vector< std::pair<int,Box> > isects;
+    for (int i = 0, N = dba.size(); i < N; ++i)
+    {
+        boxArray().intersections(dba[i], isects);
+        for (const auto& is : isects)
+        {
+            if (boxArray()[is.first].contains(dba[i]))
+            {
+                pmap[i] = DistributionMap()[is.first];
+                break;
+            }
+        }
+    }
+
+    TagBoxArray dtags(dba, DistributionMapping(pmap)); // note that dtags is filled w/ CLEAR.
+
+    dtags.copy(*this, 0, 0, 1, Periodicity::NonPeriodic(), FabArrayBase::ADD);
+
+    TheLocalRuns.clear();
+
+    // unsafe to do OMP
+    for (MFIter fai(dtags); fai.isValid(); ++fai)
+    {
+        dtags[fai].collate(TheLocalRuns);
+    }
+    //
+    // Join the runs continuing across neighboring boxes.
+    //
+    mergeTagRuns(TheLocalRuns);
+}
+
 void
 TagBoxArray::setVal (const BoxList& bl,
                      TagBox::TagVal val)
@@ -1,7 +1,13 @@
 
 #include <AMReX_Arena.H>
+#include <AMReX_BLassert.H>
 #include <AMReX.H>
 
+namespace
+{
+    amrex::Arena* the_comm_arena = 0;
+}
+
 const unsigned int amrex::Arena::align_size;
 
 amrex::Arena::~Arena () {}
@@ -13,3 +19,17 @@ amrex::Arena::align (std::size_t s)
     x -= x & (align_size-1);
     return x;
 }
+
+amrex::Arena*
+amrex::The_Comm_Arena ()
+{
+    BL_ASSERT(the_comm_arena != 0);
+
+    return the_comm_arena;
+}
+
+void
+amrex::Set_Comm_Arena (amrex::Arena* arena)
+{
+    the_comm_arena = arena;
+}
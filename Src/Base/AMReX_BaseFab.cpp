@@ -290,6 +290,35 @@ BaseFab<Real>::norm (const Box& bx,
     return nrm;
 }
 
+template<>
+Real
+BaseFab<Real>::norm (const Box&           bx,
+                     const BaseFab<Real>& wgt,
+                     int                  p,
+                     int                  comp,
+                     int                  ncomp) const
+{
+    BL_ASSERT(domain.contains(bx));
+    BL_ASSERT(wgt.box().contains(bx));
+    BL_ASSERT(comp >= 0 && comp + ncomp <= nvar);
+
+    Real nrm = 0.0;
+
+    if (p == 1 || p == 2)
+    {
+	nrm = fort_fab_norm_wgt(ARLIM_3D(bx.loVect()), ARLIM_3D(bx.hiVect()),
+				BL_TO_FORTRAN_N_3D(*this,comp),
+				BL_TO_FORTRAN_N_3D(wgt,0),
+				&ncomp, &p);
+    }
+    else
+    {
+        amrex::Error("BaseFab<Real>::norm(): only p == 1 or p == 2 are supported with weight");
+    }
+
+    return nrm;
+}
+
 template<>
 Real
 BaseFab<Real>::sum (const Box& bx,
@@ -141,6 +141,40 @@ contains
   end function fort_fab_norm
 
 
+  function fort_fab_norm_wgt (lo, hi, src, slo, shi, wgt, wlo, whi, ncomp, p) result(nrm) &
+       bind(c,name='fort_fab_norm_wgt')
+    integer, intent(in) :: lo(3), hi(3), slo(3), shi(3), wlo(3), whi(3), ncomp, p
+    real(amrex_real), intent(in) :: src(slo(1):shi(1),slo(2):shi(2),slo(3):shi(3),ncomp)
+    real(amrex_real), intent(in) :: wgt(wlo(1):whi(1),wlo(2):whi(2),wlo(3):whi(3))
+    real(amrex_real) :: nrm
+
+    integer :: i,j,k,n
+
+    nrm = 0.0_amrex_real
+    if (p .eq. 1) then
+       do n = 1, ncomp
+          do       k = lo(3), hi(3)
+             do    j = lo(2), hi(2)
+                do i = lo(1), hi(1)
+                   nrm = nrm + wgt(i,j,k)*abs(src(i,j,k,n))
+                end do
+             end do
+          end do
+       end do
+    else if (p .eq. 2) then
+       do n = 1, ncomp
+          do       k = lo(3), hi(3)
+             do    j = lo(2), hi(2)
+                do i = lo(1), hi(1)
+                   nrm = nrm + wgt(i,j,k)*src(i,j,k,n)*src(i,j,k,n)
+                end do
+             end do
+          end do
+       end do
+    end if
+  end function fort_fab_norm_wgt
+
+
   function fort_fab_sum (lo, hi, src, slo, shi, ncomp) result(sm) &
        bind(c,name='fort_fab_sum')
     integer, intent(in) :: lo(3), hi(3), slo(3), shi(3), ncomp
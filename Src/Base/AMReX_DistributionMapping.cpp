@@ -42,6 +42,9 @@ namespace amrex {
     int    sfc_threshold;
     Real   max_efficiency;
     int    node_size;
+    Real   sfccomm_tolerance;
+    int    sfccomm_max_passes;
+    Real   incremental_tolerance;
 
 // We default to SFC.
 DistributionMapping::Strategy DistributionMapping::m_Strategy = DistributionMapping::SFC;
@@ -91,6 +94,12 @@ DistributionMapping::strategy (DistributionMapping::Strategy how)
     case RRSFC:
         m_BuildMap = &DistributionMapping::RRSFCProcessorMap;
         break;
+    case SFCCOMM:
+        m_BuildMap = &DistributionMapping::SFCCommProcessorMap;
+        break;
+    case KNAPSACKNODE:
+        m_BuildMap = &DistributionMapping::KnapSackNodeProcessorMap;
+        break;
     default:
         amrex::Error("Bad DistributionMapping::Strategy");
     }
@@ -131,6 +140,9 @@ DistributionMapping::Initialize ()
     sfc_threshold    = 0;
     max_efficiency   = 0.9;
     node_size        = 0;
+    sfccomm_tolerance  = 0.1;
+    sfccomm_max_passes = 4;
+    incremental_tolerance = 0.1;
 
     ParmParse pp("DistributionMapping");
 
@@ -139,6 +151,9 @@ DistributionMapping::Initialize ()
     pp.query("efficiency",       max_efficiency);
     pp.query("sfc_threshold",    sfc_threshold);
     pp.query("node_size",        node_size);
+    pp.query("sfccomm_tolerance",  sfccomm_tolerance);
+    pp.query("sfccomm_max_passes", sfccomm_max_passes);
+    pp.query("incremental_tolerance", incremental_tolerance);
 
     std::string theStrategy;
 
@@ -165,6 +180,14 @@ DistributionMapping::Initialize ()
         {
             strategy(RRSFC);
         }
+        else if (theStrategy == "SFCCOMM")
+        {
+            strategy(SFCCOMM);
+        }
+        else if (theStrategy == "KNAPSACKNODE")
+        {
+            strategy(KNAPSACKNODE);
+        }
         else
         {
             std::string msg("Unknown strategy: ");
@@ -1317,6 +1340,388 @@ DistributionMapping::RRSFCProcessorMap (const BoxArray&          boxes,
     RRSFCDoIt(boxes,nprocs);
 }
 
+namespace
+{
+    //
+    // Sum of the weights of the edges from box i to boxes owned by rank.
+    //
+    long
+    EdgesTo (const std::vector<std::pair<int,long> >& adj,
+             const Array<int>&                         pmap,
+             int                                       rank)
+    {
+        long r = 0;
+        for (auto const& e : adj) {
+            if (pmap[e.first] == rank) r += e.second;
+        }
+        return r;
+    }
+}
+
+void
+DistributionMapping::CommVolumeRefine (const BoxArray&          boxes,
+                                       const std::vector<long>& wgts,
+                                       int                      nprocs)
+{
+    BL_PROFILE("DistributionMapping::CommVolumeRefine()");
+
+    const int N = boxes.size();
+    //
+    // Work with the ranks in m_color, 0 to nprocs-1.
+    //
+    std::map<int,int> localRank;
+    for (int i = 0; i < nprocs; ++i)
+        localRank[ParallelDescriptor::Translate(i,m_color)] = i;
+
+    Array<int> pmap(N);
+    for (int i = 0; i < N; ++i)
+    {
+        BL_ASSERT(localRank.count(m_ref->m_pmap[i]) > 0);
+        pmap[i] = localRank[m_ref->m_pmap[i]];
+    }
+    //
+    // The face adjacency graph of the boxes.  The weight of an edge is the
+    // number of cell faces shared by the two boxes.  Periodic neighbors
+    // are not considered.
+    //
+    std::vector<std::vector<std::pair<int,long> > > adj(N);
+
+    for (int i = 0; i < N; ++i)
+    {
+        const Box& bx = boxes[i];
+        std::map<int,long> nbrs;
+        for (int idim = 0; idim < BL_SPACEDIM; ++idim)
+        {
+            const std::vector< std::pair<int,Box> >& isects
+                = boxes.intersections(amrex::grow(bx,idim,1));
+            for (auto const& is : isects) {
+                if (is.first != i) nbrs[is.first] += is.second.numPts();
+            }
+        }
+        adj[i].assign(nbrs.begin(), nbrs.end());
+    }
+
+    Array<long> load(nprocs, 0);
+    Array<int>  nboxes(nprocs, 0);
+    long        total = 0;
+
+    for (int i = 0; i < N; ++i)
+    {
+        load[pmap[i]] += wgts[i];
+        nboxes[pmap[i]]++;
+        total += wgts[i];
+    }
+
+    const Real avg     = Real(total) / nprocs;
+    const long maxload = std::max(*std::max_element(load.begin(), load.end()),
+                                  long((1.0+sfccomm_tolerance)*avg));
+
+    auto cut_faces = [&] () -> long {
+        long cut = 0;
+        for (int i = 0; i < N; ++i) {
+            for (auto const& e : adj[i]) {
+                if (pmap[e.first] != pmap[i]) cut += e.second;
+            }
+        }
+        return cut/2;
+    };
+
+    const long cut_before = (verbose) ? cut_faces() : 0;
+
+    for (int pass = 0; pass < sfccomm_max_passes; ++pass)
+    {
+        int nchanged = 0;
+
+        for (int i = 0; i < N; ++i)
+        {
+            const int  p        = pmap[i];
+            const long internal = EdgesTo(adj[i], pmap, p);
+            //
+            // First try to move box i to the neighboring rank it is most
+            // connected to.
+            //
+            int  best_q    = -1;
+            long best_gain = 0;
+
+            if (nboxes[p] > 1)
+            {
+                for (auto const& e : adj[i])
+                {
+                    const int q = pmap[e.first];
+                    if (q == p || load[q] + wgts[i] > maxload) continue;
+                    const long gain = EdgesTo(adj[i], pmap, q) - internal;
+                    if (gain > best_gain)
+                    {
+                        best_gain = gain;
+                        best_q    = q;
+                    }
+                }
+            }
+
+            if (best_q >= 0)
+            {
+                pmap[i] = best_q;
+                load[p] -= wgts[i];  nboxes[p]--;
+                load[best_q] += wgts[i];  nboxes[best_q]++;
+                ++nchanged;
+                continue;
+            }
+            //
+            // Otherwise try to swap it with a neighboring box on another rank.
+            //
+            int best_k = -1;
+
+            for (auto const& e : adj[i])
+            {
+                const int k = e.first;
+                const int q = pmap[k];
+                if (q == p) continue;
+                if (load[p] - wgts[i] + wgts[k] > maxload ||
+                    load[q] - wgts[k] + wgts[i] > maxload) continue;
+                const long gain = (EdgesTo(adj[i], pmap, q) - internal)
+                    +             (EdgesTo(adj[k], pmap, p) - EdgesTo(adj[k], pmap, q))
+                    -             2*e.second;
+                if (gain > best_gain)
+                {
+                    best_gain = gain;
+                    best_k    = k;
+                }
+            }
+
+            if (best_k >= 0)
+            {
+                const int q = pmap[best_k];
+                pmap[i]      = q;
+                pmap[best_k] = p;
+                load[p] += wgts[best_k] - wgts[i];
+                load[q] += wgts[i] - wgts[best_k];
+                ++nchanged;
+            }
+        }
+
+        if (nchanged == 0) break;
+    }
+
+    for (int i = 0; i < N; ++i)
+        m_ref->m_pmap[i] = ParallelDescriptor::Translate(pmap[i],m_color);
+
+    if (verbose && ParallelDescriptor::IOProcessor())
+    {
+        const long max_wgt = *std::max_element(load.begin(), load.end());
+        std::cout << "SFCCOMM cut faces: " << cut_before << " -> " << cut_faces()
+                  << ", efficiency: " << (total/(nprocs*Real(max_wgt)))
+                  << '\n';
+    }
+}
+
+void
+DistributionMapping::SFCCommProcessorMap (const BoxArray& boxes,
+                                          int             nprocs)
+{
+    BL_ASSERT(boxes.size() > 0);
+
+    std::vector<long> wgts;
+
+    wgts.reserve(boxes.size());
+
+    for (int i = 0, N = boxes.size(); i < N; ++i)
+    {
+        wgts.push_back(boxes[i].volume());
+    }
+
+    SFCCommProcessorMap(boxes,wgts,nprocs);
+}
+
+void
+DistributionMapping::SFCCommProcessorMap (const BoxArray&          boxes,
+                                          const std::vector<long>& wgts,
+                                          int                      nprocs)
+{
+    SFCProcessorMap(boxes,wgts,nprocs);
+
+    CommVolumeRefine(boxes,wgts,nprocs);
+}
+
+void
+DistributionMapping::KnapSackNodeProcessorMap (const BoxArray& boxes,
+                                               int             nprocs)
+{
+    BL_ASSERT(boxes.size() > 0);
+
+    std::vector<long> wgts;
+
+    wgts.reserve(boxes.size());
+
+    for (int i = 0, N = boxes.size(); i < N; ++i)
+    {
+        wgts.push_back(boxes[i].volume());
+    }
+
+    KnapSackNodeProcessorMap(boxes,wgts,nprocs);
+}
+
+void
+DistributionMapping::KnapSackNodeProcessorMap (const BoxArray&          boxes,
+                                               const std::vector<long>& wgts,
+                                               int                      nprocs)
+{
+    BL_PROFILE("DistributionMapping::KnapSackNodeProcessorMap()");
+
+    BL_ASSERT(boxes.size() > 0);
+    BL_ASSERT(boxes.size() == static_cast<int>(wgts.size()));
+    BL_ASSERT(nprocs <= ParallelDescriptor::NProcs(m_color));
+
+    m_ref->m_pmap.resize(wgts.size());
+    //
+    // The processes on each node.  DistributionMapping.node_size > 0 overrides
+    // what the MPI library tells us, and groups consecutive ranks instead.
+    //
+    std::vector< std::vector<int> > noderanks;
+
+    if (node_size > 0)
+    {
+        for (int i = 0; i < nprocs; i += node_size)
+        {
+            noderanks.push_back(std::vector<int>());
+            for (int j = i; j < std::min(i+node_size,nprocs); ++j)
+                noderanks.back().push_back(j);
+        }
+    }
+    else
+    {
+        std::map<int,int> node_index;
+        for (int i = 0; i < nprocs; ++i)
+        {
+            const int node = ParallelDescriptor::NodeOfRank(ParallelDescriptor::Translate(i,m_color));
+            auto it = node_index.find(node);
+            if (it == node_index.end()) {
+                it = node_index.insert(std::make_pair(node,int(noderanks.size()))).first;
+                noderanks.push_back(std::vector<int>());
+            }
+            noderanks[it->second].push_back(i);
+        }
+    }
+
+    const int nnodes = noderanks.size();
+
+    if (nnodes == 1 || nnodes == nprocs || boxes.size() < sfc_threshold*nprocs)
+    {
+        KnapSackProcessorMap(wgts,nprocs);
+        return;
+    }
+
+    std::vector<SFCToken> tokens;
+
+    const int N = boxes.size();
+
+    tokens.reserve(N);
+
+    int maxijk = 0;
+
+    for (int i = 0; i < N; ++i)
+    {
+	const Box& bx = boxes[i];
+        tokens.push_back(SFCToken(i,bx.smallEnd(),wgts[i]));
+
+        const SFCToken& token = tokens.back();
+
+        AMREX_D_TERM(maxijk = std::max(maxijk, token.m_idx[0]);,
+               maxijk = std::max(maxijk, token.m_idx[1]);,
+               maxijk = std::max(maxijk, token.m_idx[2]););
+    }
+
+    int m = 0;
+    for ( ; (1 << m) <= maxijk; ++m) {
+        ;  // do nothing
+    }
+    SFCToken::MaxPower = m;
+    //
+    // Put'm in Morton order and cut the curve into one piece per process.
+    // Each node then takes the consecutive pieces of its processes, so it
+    // gets a compact chunk of the domain whose weight is proportional to
+    // its number of processes.
+    //
+    std::sort(tokens.begin(), tokens.end(), SFCToken::Compare());
+
+    Real volpercpu = 0;
+    for (int i = 0; i < N; ++i)
+        volpercpu += tokens[i].m_vol;
+    volpercpu /= nprocs;
+
+    std::vector< std::vector<int> > vec(nprocs);
+
+    Distribute(tokens,nprocs,volpercpu,vec);
+
+    tokens.clear();
+
+    Array<int> ord;
+
+    LeastUsedCPUs(nprocs,ord);
+
+    Array<int> rank_order(nprocs);
+    for (int i = 0; i < nprocs; ++i)
+        rank_order[ord[i]] = i;
+
+    Real sum_wgt = 0, max_wgt = 0;
+
+    for (int inode = 0, ivec = 0; inode < nnodes; ++inode)
+    {
+        std::vector<int>& ranks = noderanks[inode];
+        const int nworkers = ranks.size();
+
+        std::vector<int> vi;
+        for (int w = 0; w < nworkers; ++w, ++ivec)
+            vi.insert(vi.end(), vec[ivec].begin(), vec[ivec].end());
+
+        const int Nbx = vi.size();
+        //
+        // Knapsack the node's boxes onto its processes.
+        //
+        std::vector<long> local_wgts;
+        for (int j = 0; j < Nbx; ++j) {
+            local_wgts.push_back(wgts[vi[j]]);
+        }
+
+        std::vector<std::vector<int> > kpres;
+        Real kpeff;
+        knapsack(local_wgts, nworkers, kpres, kpeff, true, N);
+
+        std::vector<LIpair> ww;
+        for (int w = 0; w < nworkers; ++w) {
+            long wgt = 0;
+            for (std::vector<int>::const_iterator it = kpres[w].begin();
+                 it != kpres[w].end(); ++it)
+            {
+                wgt += local_wgts[*it];
+            }
+            ww.push_back(LIpair(wgt,w));
+
+            sum_wgt += wgt;
+            max_wgt = std::max(max_wgt, Real(wgt));
+        }
+        Sort(ww,true);
+        //
+        // The heaviest chunk goes to the least used process on the node.
+        //
+        std::sort(ranks.begin(), ranks.end(),
+                  [&rank_order] (int a, int b) { return rank_order[a] < rank_order[b]; });
+
+        for (int w = 0; w < nworkers; ++w)
+        {
+            const int cpu = ParallelDescriptor::Translate(ranks[w], m_color);
+            const std::vector<int>& js = kpres[ww[w].second];
+            for (std::vector<int>::const_iterator it = js.begin(); it != js.end(); ++it)
+                m_ref->m_pmap[vi[*it]] = cpu;
+        }
+    }
+
+    if (verbose && ParallelDescriptor::IOProcessor())
+    {
+        std::cout << "KNAPSACKNODE efficiency: " << (sum_wgt/(nprocs*max_wgt))
+                  << " on " << nnodes << " nodes\n";
+    }
+}
+
 namespace
 {
     struct PFCToken
@@ -2698,6 +3103,136 @@ DistributionMapping::makeSFC (const MultiFab& weight,
     return r;
 }
 
+void
+DistributionMapping::IncrementalProcessorMap (const BoxArray&            boxes,
+                                              const std::vector<long>&   wgts,
+                                              const BoxArray&            old_boxes,
+                                              const DistributionMapping& old_dm)
+{
+    BL_PROFILE("DistributionMapping::IncrementalProcessorMap()");
+
+    BL_ASSERT(boxes.size() > 0);
+    BL_ASSERT(boxes.size() == static_cast<int>(wgts.size()));
+    BL_ASSERT(old_boxes.size() == old_dm.size());
+    BL_ASSERT(boxes.ixType() == old_boxes.ixType());
+
+    const int N      = boxes.size();
+    const int nprocs = ParallelDescriptor::NProcs(m_color);
+
+    m_ref->m_pmap.resize(N);
+
+    long total = 0, wmax = 0;
+    for (int i = 0; i < N; ++i) {
+        total += wgts[i];
+        wmax = std::max(wmax, wgts[i]);
+    }
+    const long maxload = std::max(wmax, long((1.0+incremental_tolerance)*Real(total)/nprocs));
+    //
+    // For each new box, the number of its cells owned by each old owner,
+    // with the largest owner first.
+    //
+    std::vector<std::vector<LIpair> > owners(N);
+    std::vector<LIpair> order;
+    order.reserve(N);
+
+    for (int i = 0; i < N; ++i)
+    {
+        std::map<int,long> cells;
+        for (auto const& is : old_boxes.intersections(boxes[i])) {
+            cells[old_dm[is.first]] += is.second.numPts();
+        }
+        for (auto const& kv : cells) {
+            owners[i].push_back(LIpair(kv.second, kv.first));
+        }
+        std::stable_sort(owners[i].begin(), owners[i].end(), LIpairGT());
+        order.push_back(LIpair(owners[i].empty() ? 0L : owners[i][0].first, i));
+    }
+    //
+    // Place the boxes with the most data to lose first.
+    //
+    std::stable_sort(order.begin(), order.end(), LIpairGT());
+
+    std::map<int,long> load;
+    for (int i = 0; i < nprocs; ++i) {
+        load[ParallelDescriptor::Translate(i,m_color)] = 0;
+    }
+
+    std::vector<LIpair> deferred;
+    long kept = 0, overlap = 0;
+
+    for (auto const& o : order)
+    {
+        const int i = o.second;
+        for (auto const& c : owners[i]) {
+            overlap += c.first;
+        }
+        bool placed = false;
+        for (auto const& c : owners[i])
+        {
+            auto it = load.find(c.second);
+            if (it != load.end() && it->second + wgts[i] <= maxload)
+            {
+                m_ref->m_pmap[i] = c.second;
+                it->second += wgts[i];
+                kept += c.first;
+                placed = true;
+                break;
+            }
+        }
+        if (!placed) {
+            deferred.push_back(LIpair(wgts[i], i));
+        }
+    }
+    //
+    // The rest go to the least loaded processes, heaviest first.
+    //
+    std::stable_sort(deferred.begin(), deferred.end(), LIpairGT());
+
+    std::priority_queue<LIpair,std::vector<LIpair>,LIpairGT> pq;
+    for (auto const& kv : load) {
+        pq.push(LIpair(kv.second, kv.first));
+    }
+
+    for (auto const& d : deferred)
+    {
+        LIpair lp = pq.top();
+        pq.pop();
+        m_ref->m_pmap[d.second] = lp.second;
+        lp.first += d.first;
+        pq.push(lp);
+    }
+
+    if (verbose && ParallelDescriptor::IOProcessor())
+    {
+        long max_wgt = 0;
+        while (!pq.empty()) {
+            max_wgt = std::max(max_wgt, pq.top().first);
+            pq.pop();
+        }
+        std::cout << "Incremental DM: " << kept << " of " << overlap
+                  << " overlapping cells stay in place, efficiency: "
+                  << (total/(nprocs*Real(max_wgt))) << '\n';
+    }
+}
+
+DistributionMapping
+DistributionMapping::makeIncremental (const BoxArray&            boxes,
+                                      const BoxArray&            old_boxes,
+                                      const DistributionMapping& old_dm)
+{
+    DistributionMapping r;
+
+    std::vector<long> wgts;
+    wgts.reserve(boxes.size());
+    for (int i = 0, N = boxes.size(); i < N; ++i) {
+        wgts.push_back(boxes[i].numPts());
+    }
+
+    r.IncrementalProcessorMap(boxes, wgts, old_boxes, old_dm);
+
+    return r;
+}
+
 std::ostream&
 operator<< (std::ostream&              os,
             const DistributionMapping& pmap)
@@ -1,9 +1,12 @@
 
+#include <limits>
+
 #include <AMReX_FabArrayBase.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Geometry.H>
 #include <AMReX_FArrayBox.H>
+#include <AMReX_PArena.H>
 
 #ifdef BL_MEM_PROFILING
 #include <AMReX_MemProfiler.H>
@@ -20,6 +23,10 @@ namespace amrex {
 // Set default values in Initialize()!!!
 //
 bool    FabArrayBase::do_async_sends;
+bool    FabArrayBase::use_persistent_fb;
+bool    FabArrayBase::use_comm_arena;
+int     FabArrayBase::comm_arena_max_mb;
+bool    FabArrayBase::use_neighbor_fb;
 int     FabArrayBase::MaxComp;
 #if BL_SPACEDIM == 1
 IntVect FabArrayBase::mfiter_tile_size(1024000);
@@ -38,15 +45,21 @@ FabArrayBase::FBCache              FabArrayBase::m_TheFBCache;
 FabArrayBase::CPCache              FabArrayBase::m_TheCPCache;
 FabArrayBase::FPinfoCache          FabArrayBase::m_TheFillPatchCache;
 FabArrayBase::CFinfoCache          FabArrayBase::m_TheCrseFineCache;
+FabArrayBase::OMinfoCache          FabArrayBase::m_TheOverlapMaskCache;
 
 FabArrayBase::CacheStats           FabArrayBase::m_TAC_stats("TileArrayCache");
 FabArrayBase::CacheStats           FabArrayBase::m_FBC_stats("FBCache");
 FabArrayBase::CacheStats           FabArrayBase::m_CPC_stats("CopyCache");
 FabArrayBase::CacheStats           FabArrayBase::m_FPinfo_stats("FillPatchCache");
 FabArrayBase::CacheStats           FabArrayBase::m_CFinfo_stats("CrseFineCache");
+FabArrayBase::CacheStats           FabArrayBase::m_OMinfo_stats("OverlapMaskCache");
 
 std::map<FabArrayBase::BDKey, int> FabArrayBase::m_BD_count;
 
+#ifdef BL_USE_MPI
+MPI_Comm FabArrayBase::persistent_fb_comm = MPI_COMM_NULL;
+#endif
+
 FabArrayBase::FabArrayStats        FabArrayBase::m_FA_stats;
 
 namespace
@@ -77,6 +90,10 @@ FabArrayBase::Initialize ()
     // Set default values here!!!
     //
     FabArrayBase::do_async_sends    = true;
+    FabArrayBase::use_persistent_fb = false;
+    FabArrayBase::use_comm_arena    = true;
+    FabArrayBase::comm_arena_max_mb = 256;
+    FabArrayBase::use_neighbor_fb   = false;
     FabArrayBase::MaxComp           = 25;
 
     ParmParse pp("fabarray");
@@ -100,10 +117,32 @@ FabArrayBase::Initialize ()
 
     pp.query("maxcomp",             FabArrayBase::MaxComp);
     pp.query("do_async_sends",      FabArrayBase::do_async_sends);
+    pp.query("use_persistent_fb",   FabArrayBase::use_persistent_fb);
+    pp.query("use_comm_arena",      FabArrayBase::use_comm_arena);
+    pp.query("comm_arena_max_mb",   FabArrayBase::comm_arena_max_mb);
+    pp.query("use_neighbor_fb",     FabArrayBase::use_neighbor_fb);
+
+#if !defined(BL_USE_MPI3)
+    if (FabArrayBase::use_neighbor_fb) {
+        if (ParallelDescriptor::IOProcessor()) {
+            amrex::Warning("fabarray.use_neighbor_fb requires USE_MPI3=TRUE; ignored");
+        }
+        FabArrayBase::use_neighbor_fb = false;
+    }
+#endif
 
     if (MaxComp < 1)
         MaxComp = 1;
 
+    if (FabArrayBase::use_comm_arena) {
+        const std::size_t max_pooled = (FabArrayBase::comm_arena_max_mb < 0)
+            ? std::numeric_limits<std::size_t>::max()
+            : static_cast<std::size_t>(FabArrayBase::comm_arena_max_mb) * 1024 * 1024;
+        amrex::Set_Comm_Arena(new PArena(0, max_pooled));
+    } else {
+        amrex::Set_Comm_Arena(amrex::The_Arena());
+    }
+
     FabArrayBase::nFabArrays = 0;
 
     amrex::ExecOnFinalize(FabArrayBase::Finalize);
@@ -129,6 +168,10 @@ FabArrayBase::Initialize ()
 		     ([] () -> MemProfiler::MemInfo {
 			 return {m_CFinfo_stats.bytes, m_CFinfo_stats.bytes_hwm};
 		     }));
+    MemProfiler::add(m_OMinfo_stats.name, std::function<MemProfiler::MemInfo()>
+		     ([] () -> MemProfiler::MemInfo {
+			 return {m_OMinfo_stats.bytes, m_OMinfo_stats.bytes_hwm};
+		     }));
 #endif
 }
 
@@ -576,7 +619,8 @@ FabArrayBase::FB::FB (const FabArrayBase& fa, bool cross, const Periodicity& per
       m_RcvTags(new CopyComTag::MapOfCopyComTagContainers),
       m_SndVols(new CopyComTag::MapOfCopyComTagContainers),
       m_RcvVols(new CopyComTag::MapOfCopyComTagContainers),
-      m_nuse(0)
+      m_nuse(0),
+      m_ncomm(MPI_COMM_NULL)
 {
     BL_PROFILE("FabArrayBase::FB::FB()");
 
@@ -986,6 +1030,146 @@ FabArrayBase::FB::~FB ()
     delete m_RcvTags;
     delete m_SndVols;
     delete m_RcvVols;
+#if defined(BL_USE_MPI3)
+    if (m_ncomm != MPI_COMM_NULL) {
+        MPI_Comm_free(&m_ncomm);
+    }
+#endif
+}
+
+FabArrayBase::FB::PersistentComm::~PersistentComm ()
+{
+#ifdef BL_USE_MPI
+    BL_ASSERT(!in_use);
+    for (auto& req : send_reqs) {
+        if (req != MPI_REQUEST_NULL) MPI_Request_free(&req);
+    }
+    for (auto& req : recv_reqs) {
+        if (req != MPI_REQUEST_NULL) MPI_Request_free(&req);
+    }
+#endif
+    if (the_send_data) amrex::The_Arena()->free(the_send_data);
+    if (the_recv_data) amrex::The_Arena()->free(the_recv_data);
+}
+
+FabArrayBase::FB::PersistentComm*
+FabArrayBase::FB::getPersistentComm (int bytes_per_cell) const
+{
+#ifdef BL_USE_MPI
+    auto it = m_pcomm.find(bytes_per_cell);
+    if (it != m_pcomm.end()) {
+        return (it->second->in_use) ? nullptr : it->second.get();
+    }
+
+    BL_PROFILE("FabArrayBase::FB::getPersistentComm()");
+
+    // Made with the first plan, so use_persistent_fb may also be set after
+    // Initialize.  All processes build their plans together, as MPI_Comm_dup needs.
+    if (persistent_fb_comm == MPI_COMM_NULL) {
+        BL_MPI_REQUIRE( MPI_Comm_dup(ParallelDescriptor::Communicator(), &persistent_fb_comm) );
+    }
+
+    // All processes build their plans in the same order, so they agree on the tag.
+    const int tag = ParallelDescriptor::SeqNum();
+
+    std::unique_ptr<PersistentComm> pc(new PersistentComm);
+
+    std::size_t tot_send = 0;
+    for (auto const& kv : *m_SndVols)
+    {
+        std::size_t nbytes = 0;
+        for (auto const& cct : kv.second) {
+            nbytes += cct.sbox.numPts() * bytes_per_cell;
+        }
+        BL_ASSERT(nbytes < std::numeric_limits<int>::max());
+        pc->send_size.push_back(static_cast<int>(nbytes));
+        pc->send_rank.push_back(kv.first);
+        tot_send += nbytes;
+    }
+
+    std::size_t tot_recv = 0;
+    for (auto const& kv : *m_RcvVols)
+    {
+        std::size_t nbytes = 0;
+        for (auto const& cct : kv.second) {
+            nbytes += cct.dbox.numPts() * bytes_per_cell;
+        }
+        BL_ASSERT(nbytes < std::numeric_limits<int>::max());
+        pc->recv_size.push_back(static_cast<int>(nbytes));
+        pc->recv_from.push_back(kv.first);
+        tot_recv += nbytes;
+    }
+
+    if (tot_send > 0) {
+        pc->the_send_data = static_cast<char*>(amrex::The_Arena()->alloc(tot_send));
+    }
+    if (tot_recv > 0) {
+        pc->the_recv_data = static_cast<char*>(amrex::The_Arena()->alloc(tot_recv));
+    }
+
+    const int N_snds = pc->send_size.size();
+    pc->send_data.resize(N_snds, nullptr);
+    pc->send_reqs.resize(N_snds, MPI_REQUEST_NULL);
+    std::size_t offset = 0;
+    for (int j = 0; j < N_snds; ++j)
+    {
+        if (pc->send_size[j] > 0) {
+            pc->send_data[j] = pc->the_send_data + offset;
+            BL_MPI_REQUIRE( MPI_Send_init(pc->send_data[j], pc->send_size[j], MPI_CHAR,
+                                          pc->send_rank[j], tag, persistent_fb_comm,
+                                          &(pc->send_reqs[j])) );
+            offset += pc->send_size[j];
+        }
+    }
+
+    const int N_rcvs = pc->recv_size.size();
+    pc->recv_data.resize(N_rcvs, nullptr);
+    pc->recv_reqs.resize(N_rcvs, MPI_REQUEST_NULL);
+    offset = 0;
+    for (int k = 0; k < N_rcvs; ++k)
+    {
+        if (pc->recv_size[k] > 0) {
+            pc->recv_data[k] = pc->the_recv_data + offset;
+            BL_MPI_REQUIRE( MPI_Recv_init(pc->recv_data[k], pc->recv_size[k], MPI_CHAR,
+                                          pc->recv_from[k], tag, persistent_fb_comm,
+                                          &(pc->recv_reqs[k])) );
+            offset += pc->recv_size[k];
+        }
+    }
+
+    PersistentComm* r = pc.get();
+    m_pcomm[bytes_per_cell] = std::move(pc);
+    return r;
+#else
+    return nullptr;
+#endif
+}
+
+MPI_Comm
+FabArrayBase::FB::getNeighborComm () const
+{
+#if defined(BL_USE_MPI3)
+    if (m_ncomm == MPI_COMM_NULL)
+    {
+        BL_PROFILE("FabArrayBase::FB::getNeighborComm()");
+
+        Array<int> sources, destinations;
+        for (auto const& kv : *m_RcvVols) {
+            sources.push_back(kv.first);
+        }
+        for (auto const& kv : *m_SndVols) {
+            destinations.push_back(kv.first);
+        }
+
+        BL_MPI_REQUIRE( MPI_Dist_graph_create_adjacent(ParallelDescriptor::Communicator(),
+                                                       sources.size(), sources.dataPtr(),
+                                                       MPI_UNWEIGHTED,
+                                                       destinations.size(), destinations.dataPtr(),
+                                                       MPI_UNWEIGHTED,
+                                                       MPI_INFO_NULL, 0, &m_ncomm) );
+    }
+#endif
+    return m_ncomm;
 }
 
 void
@@ -1004,6 +1188,14 @@ FabArrayBase::flushFB (bool no_assertion) const
     m_TheFBCache.erase(er_it.first, er_it.second);
 }
 
+void
+FabArrayBase::releaseCommArena ()
+{
+    if (FabArrayBase::use_comm_arena && initialized) {
+        static_cast<PArena*>(amrex::The_Comm_Arena())->release();
+    }
+}
+
 void
 FabArrayBase::flushFBCache ()
 {
@@ -1062,12 +1254,14 @@ FabArrayBase::FPinfo::FPinfo (const FabArrayBase& srcfa,
 			      const Box&          dstdomain,
 			      int                 dstng,
 			      const BoxConverter& coarsener,
-                              const Box&          cdomain)
+                              const Box&          cdomain,
+                              const Periodicity&  period)
     : m_srcbdk   (srcfa.getBDKey()),
       m_dstbdk   (dstfa.getBDKey()),
       m_dstdomain(dstdomain),
       m_dstng    (dstng),
       m_coarsener(coarsener.clone()),
+      m_period   (period),
       m_nuse     (0)
 { 
     BL_PROFILE("FPinfo::FPinfo()");
@@ -1085,6 +1279,19 @@ FabArrayBase::FPinfo::FPinfo (const FabArrayBase& srcfa,
     
     const int myproc = ParallelDescriptor::MyProc();
 
+    //
+    // Ghost cells outside the periodic domain are filled from the
+    // periodic images of the source, so only those no image covers
+    // need coarse data.
+    //
+    const Box& pdomain = amrex::convert(m_period.Domain(), boxtype);
+    std::vector<IntVect> pshifts;
+    for (const auto& iv : m_period.shiftIntVect()) {
+	if (iv != IntVect::TheZeroVector()) {
+	    pshifts.push_back(iv);
+	}
+    }
+
     BoxList bl(boxtype);
     Array<int> iprocs;
 
@@ -1096,6 +1303,23 @@ FabArrayBase::FPinfo::FPinfo (const FabArrayBase& srcfa,
 
 	BoxList leftover = srcba.complementIn(bx);
 
+	if (!pshifts.empty() && !leftover.isEmpty() && !pdomain.contains(bx))
+	{
+	    for (const auto& iv : pshifts)
+	    {
+		BoxList uncovered(boxtype);
+		for (BoxList::const_iterator bli = leftover.begin(); bli != leftover.end(); ++bli)
+		{
+		    BoxList bl_iv = srcba.complementIn(*bli - iv);
+		    for (BoxList::const_iterator it = bl_iv.begin(); it != bl_iv.end(); ++it) {
+			uncovered.push_back(*it + iv);
+		    }
+		}
+		leftover = uncovered;
+		if (leftover.isEmpty()) break;
+	    }
+	}
+
 	bool ismybox = (dstdm[i] == myproc);
 	for (BoxList::const_iterator bli = leftover.begin(); bli != leftover.end(); ++bli)
 	{
@@ -1140,7 +1364,8 @@ FabArrayBase::TheFPinfo (const FabArrayBase& srcfa,
 			 const Box&          dstdomain,
 			 int                 dstng,
 			 const BoxConverter& coarsener,
-                         const Box&          cdomain)
+                         const Box&          cdomain,
+                         const Periodicity&  period)
 {
     BL_PROFILE("FabArrayBase::TheFPinfo()");
 
@@ -1155,6 +1380,7 @@ FabArrayBase::TheFPinfo (const FabArrayBase& srcfa,
 	    it->second->m_dstbdk    == dstkey    &&
 	    it->second->m_dstdomain == dstdomain &&
 	    it->second->m_dstng     == dstng     &&
+	    it->second->m_period    == period    &&
 	    it->second->m_dstdomain.ixType() == dstdomain.ixType() &&
 	    it->second->m_coarsener->doit(it->second->m_dstdomain) == coarsener.doit(dstdomain))
 	{
@@ -1165,7 +1391,7 @@ FabArrayBase::TheFPinfo (const FabArrayBase& srcfa,
     }
 
     // Have to build a new one
-    FPinfo* new_fpc = new FPinfo(srcfa, dstfa, dstdomain, dstng, coarsener, cdomain);
+    FPinfo* new_fpc = new FPinfo(srcfa, dstfa, dstdomain, dstng, coarsener, cdomain, period);
 
 #ifdef BL_MEM_PROFILING
     m_FPinfo_stats.bytes += new_fpc->bytes();
@@ -1358,11 +1584,156 @@ FabArrayBase::flushCFinfo (bool no_assertion)
     m_TheCrseFineCache.erase(er_it.first, er_it.second);
 }
 
+FabArrayBase::OMinfo::OMinfo (const FabArrayBase& fa, const Periodicity& period)
+    : m_bdk(fa.getBDKey()),
+      m_typ(fa.boxArray().ixType()),
+      m_crse_ratio(fa.boxArray().crseRatio()),
+      m_period(period),
+      m_nuse(0)
+{
+    BL_PROFILE("FabArrayBase::OMinfo::OMinfo()");
+
+    const BoxArray&   ba   = fa.boxArray();
+    const Array<int>& imap = fa.IndexArray();
+    const int         N    = imap.size();
+
+    m_wgt.resize(N, 0);
+
+    const std::vector<IntVect>& pshifts = period.shiftIntVect();
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector< std::pair<int,Box> > isects;
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (int li = 0; li < N; ++li)
+        {
+            const int  i  = imap[li];
+            const Box& bx = ba[i];
+
+            FArrayBox* fab = 0;
+
+            for (const auto& iv : pshifts)
+            {
+                ba.intersections(bx+iv, isects);
+                for (const auto& is : isects)
+                {
+                    if (is.first == i && iv == IntVect::TheZeroVector()) continue;
+                    if (fab == 0) {
+                        fab = new FArrayBox(bx,1);
+                        fab->setVal(1.0);
+                    }
+                    fab->plus(1.0, is.second-iv);
+                }
+            }
+
+            // Points covered by only this box keep a weight of one, so
+            // boxes without any overlap need no weight at all.
+            if (fab) fab->invert(1.0);
+
+            m_wgt[li] = fab;
+        }
+    }
+}
+
+FabArrayBase::OMinfo::~OMinfo ()
+{
+    for (int i = 0, N = m_wgt.size(); i < N; ++i)
+        delete m_wgt[i];
+}
+
+long
+FabArrayBase::OMinfo::bytes () const
+{
+    long cnt = sizeof(FabArrayBase::OMinfo);
+    cnt += sizeof(FArrayBox*) * m_wgt.capacity();
+    for (int i = 0, N = m_wgt.size(); i < N; ++i)
+        if (m_wgt[i]) cnt += m_wgt[i]->nBytes();
+    return cnt;
+}
+
+const FabArrayBase::OMinfo&
+FabArrayBase::getOMinfo (const Periodicity& period) const
+{
+    BL_PROFILE("FabArrayBase::getOMinfo()");
+
+    BL_ASSERT(getBDKey() == m_bdkey);
+    auto er_it = m_TheOverlapMaskCache.equal_range(m_bdkey);
+    for (auto it = er_it.first; it != er_it.second; ++it)
+    {
+        if (it->second->m_typ        == boxArray().ixType()    &&
+            it->second->m_crse_ratio == boxArray().crseRatio() &&
+            it->second->m_period     == period)
+        {
+            ++(it->second->m_nuse);
+            m_OMinfo_stats.recordUse();
+            return *(it->second);
+        }
+    }
+
+    // Have to build a new one
+    OMinfo* new_ominfo = new OMinfo(*this, period);
+
+#ifdef BL_MEM_PROFILING
+    m_OMinfo_stats.bytes += new_ominfo->bytes();
+    m_OMinfo_stats.bytes_hwm = std::max(m_OMinfo_stats.bytes_hwm, m_OMinfo_stats.bytes);
+#endif
+
+    new_ominfo->m_nuse = 1;
+    m_OMinfo_stats.recordBuild();
+    m_OMinfo_stats.recordUse();
+
+    m_TheOverlapMaskCache.insert(er_it.second, OMinfoCache::value_type(m_bdkey,new_ominfo));
+
+    return *new_ominfo;
+}
+
+void
+FabArrayBase::flushOMinfo (bool no_assertion) const
+{
+    BL_ASSERT(no_assertion || getBDKey() == m_bdkey);
+    auto er_it = m_TheOverlapMaskCache.equal_range(m_bdkey);
+    for (auto it = er_it.first; it != er_it.second; ++it)
+    {
+#ifdef BL_MEM_PROFILING
+        m_OMinfo_stats.bytes -= it->second->bytes();
+#endif
+        m_OMinfo_stats.recordErase(it->second->m_nuse);
+        delete it->second;
+    }
+    m_TheOverlapMaskCache.erase(er_it.first, er_it.second);
+}
+
+void
+FabArrayBase::flushOMinfoCache ()
+{
+    for (auto it = m_TheOverlapMaskCache.begin(); it != m_TheOverlapMaskCache.end(); ++it)
+    {
+        m_OMinfo_stats.recordErase(it->second->m_nuse);
+        delete it->second;
+    }
+    m_TheOverlapMaskCache.clear();
+#ifdef BL_MEM_PROFILING
+    m_OMinfo_stats.bytes = 0L;
+#endif
+}
+
 void
 FabArrayBase::Finalize ()
 {
     FabArrayBase::flushFBCache();
     FabArrayBase::flushCPCache();
+    FabArrayBase::flushOMinfoCache();
+
+#ifdef BL_USE_MPI
+    if (persistent_fb_comm != MPI_COMM_NULL) {
+        BL_MPI_REQUIRE( MPI_Comm_free(&persistent_fb_comm) );
+    }
+#endif
 
     FabArrayBase::flushTileArrayCache();
 
@@ -1373,7 +1744,31 @@ FabArrayBase::Finalize ()
 	m_CPC_stats.print();
 	m_FPinfo_stats.print();
 	m_CFinfo_stats.print();
+	m_OMinfo_stats.print();
+    }
+
+    if (FabArrayBase::use_comm_arena)
+    {
+        PArena* pa = static_cast<PArena*>(amrex::The_Comm_Arena());
+
+        if (amrex::system::verbose)
+        {
+            long hwm[2] = { static_cast<long>(pa->heap_space_used_hwm()),
+                            static_cast<long>(pa->heap_space_actually_used_hwm()) };
+            long cnt[2] = { pa->num_allocs(), pa->num_reuses() };
+            ParallelDescriptor::ReduceLongMax(hwm, 2, ParallelDescriptor::IOProcessorNumber());
+            ParallelDescriptor::ReduceLongSum(cnt, 2, ParallelDescriptor::IOProcessorNumber());
+            if (cnt[0] > 0) {
+                const double MB = 1024.*1024.;
+                amrex::Print() << "CommArena: max held in a rank: " << hwm[0]/MB << " MB, "
+                               << "max in use in a rank: " << hwm[1]/MB << " MB, "
+                               << "allocs: " << cnt[0] << ", reused: " << cnt[1] << "\n";
+            }
+        }
+
+        delete pa;
     }
+    amrex::Set_Comm_Arena(0);
 
     initialized = false;
 }
@@ -1581,8 +1976,10 @@ FabArrayBase::clearThisBD (bool no_assertion)
 		flushTileArray(IntVect::TheZeroVector(), no_assertion);
 		flushFPinfo(no_assertion);
 		flushCFinfo(no_assertion);
+		flushOMinfo(no_assertion);
 		flushFB(no_assertion);
 		flushCPC(no_assertion);
+		releaseCommArena();
 	    }
 	}
     }
@@ -1633,7 +2030,7 @@ FabArrayBase::WaitForAsyncSends (int                 N_snds,
 
     for (int i = 0; i < N_snds; i++) {
         if (send_data[i]) {
-            amrex::The_Arena()->free(send_data[i]);
+            amrex::The_Comm_Arena()->free(send_data[i]);
         }
     }
 #endif /*BL_USE_MPI*/
@@ -0,0 +1,142 @@
+
+#include <cstring>
+
+#include <AMReX_FabChecksum.H>
+
+namespace amrex {
+
+namespace
+{
+    const uint64_t P1 = 11400714785074694791ULL;
+    const uint64_t P2 = 14029467366897019727ULL;
+    const uint64_t P3 =  1609587929392839161ULL;
+    const uint64_t P4 =  9650029242287828579ULL;
+    const uint64_t P5 =  2870177450012600261ULL;
+
+    inline uint64_t
+    rotl (uint64_t v, int r)
+    {
+        return (v << r) | (v >> (64 - r));
+    }
+
+    inline uint64_t
+    read64 (const unsigned char* p)
+    {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+    inline uint32_t
+    read32 (const unsigned char* p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    inline uint64_t
+    mixLane (uint64_t acc, uint64_t v)
+    {
+        acc += v * P2;
+        acc  = rotl(acc, 31);
+        return acc * P1;
+    }
+
+    inline uint64_t
+    merge (uint64_t h, uint64_t lane)
+    {
+        h ^= mixLane(0, lane);
+        return h * P1 + P4;
+    }
+}
+
+FabChecksum::FabChecksum (uint64_t seed)
+    :
+    m_seed(seed),
+    m_total(0),
+    m_nbuf(0)
+{
+    m_lane[0] = seed + P1 + P2;
+    m_lane[1] = seed + P2;
+    m_lane[2] = seed;
+    m_lane[3] = seed - P1;
+}
+
+void
+FabChecksum::update (const void* data, long nbytes)
+{
+    const unsigned char* p   = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + nbytes;
+
+    m_total += nbytes;
+
+    if (m_nbuf > 0)
+    {
+        const long n = (32 - m_nbuf < nbytes) ? 32 - m_nbuf : nbytes;
+        std::memcpy(m_buf + m_nbuf, p, n);
+        m_nbuf += n;
+        p      += n;
+        if (m_nbuf < 32)
+            return;
+        for (int l = 0; l < 4; ++l)
+            m_lane[l] = mixLane(m_lane[l], read64(m_buf + 8*l));
+        m_nbuf = 0;
+    }
+
+    for ( ; end - p >= 32; p += 32)
+    {
+        m_lane[0] = mixLane(m_lane[0], read64(p));
+        m_lane[1] = mixLane(m_lane[1], read64(p + 8));
+        m_lane[2] = mixLane(m_lane[2], read64(p + 16));
+        m_lane[3] = mixLane(m_lane[3], read64(p + 24));
+    }
+
+    if (p < end)
+    {
+        std::memcpy(m_buf, p, end - p);
+        m_nbuf = end - p;
+    }
+}
+
+uint64_t
+FabChecksum::value () const
+{
+    uint64_t h;
+
+    if (m_total >= 32)
+    {
+        h = rotl(m_lane[0], 1) + rotl(m_lane[1], 7) + rotl(m_lane[2], 12) + rotl(m_lane[3], 18);
+        for (int l = 0; l < 4; ++l)
+            h = merge(h, m_lane[l]);
+    }
+    else
+    {
+        h = m_seed + P5;
+    }
+
+    h += m_total;
+
+    const unsigned char* p   = m_buf;
+    const unsigned char* end = m_buf + m_nbuf;
+
+    for ( ; end - p >= 8; p += 8)
+        h = rotl(h ^ mixLane(0, read64(p)), 27) * P1 + P4;
+    if (end - p >= 4)
+    {
+        h = rotl(h ^ (uint64_t(read32(p)) * P1), 23) * P2 + P3;
+        p += 4;
+    }
+    for ( ; p < end; ++p)
+        h = rotl(h ^ (*p * P5), 11) * P1;
+
+    h ^= h >> 33;
+    h *= P2;
+    h ^= h >> 29;
+    h *= P3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+}
@@ -0,0 +1,396 @@
+
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <istream>
+
+#include <AMReX_FabCompress.H>
+#include <AMReX_BLassert.H>
+#include <AMReX.H>
+
+namespace amrex {
+
+namespace
+{
+    //
+    // The LZ77 coder.  A sequence is a token byte (literal length in the
+    // high nibble, match length - MinMatch in the low nibble, 15 meaning
+    // more length bytes follow), the literals, and a two byte offset.
+    // The last sequence has literals only.
+    //
+    const int  MinMatch  = 4;
+    const int  HashLog   = 14;
+    const long MaxOffset = 65535;
+
+    inline uint32_t
+    read32 (const unsigned char* p)
+    {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return v;
+    }
+
+    inline uint32_t
+    hash32 (uint32_t v)
+    {
+        return (v * 2654435761U) >> (32 - HashLog);
+    }
+
+    inline void
+    putLength (std::vector<char>& out, long len)
+    {
+        len -= 15;
+        for ( ; len >= 255; len -= 255)
+            out.push_back(static_cast<char>(255));
+        out.push_back(static_cast<char>(len));
+    }
+
+    inline long
+    getLength (const unsigned char*& ip, const unsigned char* iend)
+    {
+        long len = 15;
+        unsigned char b;
+        do {
+            if (ip >= iend)
+                amrex::Error("FabCompress: corrupt block");
+            b = *ip++;
+            len += b;
+        } while (b == 255);
+        return len;
+    }
+
+    void
+    putSequence (std::vector<char>& out, const unsigned char* lit, long litlen,
+                 long offset, long matchlen)
+    {
+        const long ml = matchlen - MinMatch;
+        unsigned char token = static_cast<unsigned char>(std::min(litlen, 15L) << 4);
+        if (matchlen > 0)
+            token |= static_cast<unsigned char>(std::min(ml, 15L));
+        out.push_back(static_cast<char>(token));
+        if (litlen >= 15)
+            putLength(out, litlen);
+        out.insert(out.end(), lit, lit + litlen);
+        if (matchlen > 0)
+        {
+            out.push_back(static_cast<char>(offset & 0xff));
+            out.push_back(static_cast<char>((offset >> 8) & 0xff));
+            if (ml >= 15)
+                putLength(out, ml);
+        }
+    }
+
+    void
+    lzCompress (const unsigned char* in, long n, std::vector<char>& out)
+    {
+        std::vector<long> table(1 << HashLog, -1);
+
+        long anchor = 0, i = 0;
+
+        while (i + MinMatch <= n)
+        {
+            const uint32_t v = read32(in + i);
+            const uint32_t h = hash32(v);
+            const long   ref = table[h];
+            table[h] = i;
+
+            if (ref >= 0 && i - ref <= MaxOffset && read32(in + ref) == v)
+            {
+                long len = MinMatch;
+                while (i + len < n && in[ref + len] == in[i + len])
+                    ++len;
+                putSequence(out, in + anchor, i - anchor, i - ref, len);
+                i += len;
+                anchor = i;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        putSequence(out, in + anchor, n - anchor, 0, 0);
+    }
+
+    void
+    lzDecompress (const unsigned char* in, long inBytes, unsigned char* out, long outBytes)
+    {
+        const unsigned char* ip   = in;
+        const unsigned char* iend = in + inBytes;
+        unsigned char*       op   = out;
+        unsigned char*       oend = out + outBytes;
+
+        while (ip < iend)
+        {
+            const unsigned token = *ip++;
+
+            long litlen = token >> 4;
+            if (litlen == 15)
+                litlen = getLength(ip, iend);
+            if (litlen > iend - ip || litlen > oend - op)
+                amrex::Error("FabCompress: corrupt block");
+            std::memcpy(op, ip, litlen);
+            op += litlen;
+            ip += litlen;
+
+            if (ip >= iend)
+                break;
+
+            if (iend - ip < 2)
+                amrex::Error("FabCompress: corrupt block");
+            const long offset = ip[0] | (static_cast<long>(ip[1]) << 8);
+            ip += 2;
+
+            long ml = token & 15;
+            if (ml == 15)
+                ml = getLength(ip, iend);
+            ml += MinMatch;
+
+            if (offset == 0 || offset > op - out || ml > oend - op)
+                amrex::Error("FabCompress: corrupt block");
+
+            const unsigned char* ref = op - offset;
+            for (long k = 0; k < ml; ++k)
+                op[k] = ref[k];
+            op += ml;
+        }
+
+        if (op != oend)
+            amrex::Error("FabCompress: corrupt block");
+    }
+
+    void
+    putInt64 (char* p, uint64_t v)
+    {
+        for (int b = 0; b < 8; ++b)
+            p[b] = static_cast<char>((v >> (8*b)) & 0xff);
+    }
+
+    uint64_t
+    getInt64 (const char* p)
+    {
+        uint64_t v = 0;
+        for (int b = 0; b < 8; ++b)
+            v |= static_cast<uint64_t>(static_cast<unsigned char>(p[b])) << (8*b);
+        return v;
+    }
+
+    //
+    // Reserve a block header at the end of out and return its position.
+    //
+    long
+    beginBlock (std::vector<char>& out)
+    {
+        const long pos = out.size();
+        out.resize(pos + FabCompress::BlockHeaderBytes);
+        return pos;
+    }
+
+    void
+    endBlock (std::vector<char>& out, long pos, int mode)
+    {
+        putInt64(&out[pos], out.size() - pos - FabCompress::BlockHeaderBytes);
+        out[pos + 8] = static_cast<char>(mode);
+    }
+}
+
+int
+FabCompress::compressLossless (const char* data, long n, int elemBytes,
+                               std::vector<char>& out)
+{
+    const long nbytes = n * elemBytes;
+    //
+    // Group the bytes by significance, so the slowly varying exponent
+    // and high mantissa bytes of neighboring values line up.
+    //
+    std::vector<unsigned char> shuffled(nbytes);
+    for (int b = 0; b < elemBytes; ++b)
+    {
+        unsigned char* dst = &shuffled[0] + b*n;
+        for (long i = 0; i < n; ++i)
+            dst[i] = data[i*elemBytes + b];
+    }
+
+    const long pos = beginBlock(out);
+
+    if (nbytes > 0)
+        lzCompress(shuffled.data(), nbytes, out);
+
+    if (static_cast<long>(out.size()) - pos - BlockHeaderBytes < nbytes)
+    {
+        endBlock(out, pos, ShuffleLZ);
+        return ShuffleLZ;
+    }
+
+    out.resize(pos + BlockHeaderBytes);
+    out.insert(out.end(), data, data + nbytes);
+    endBlock(out, pos, Stored);
+    return Stored;
+}
+
+int
+FabCompress::compressErrorBounded (const Real* data, long n, Real tol,
+                                   std::vector<char>& out)
+{
+    const char* cdata  = reinterpret_cast<const char*>(data);
+    const long  nbytes = n * sizeof(Real);
+
+    if ( ! (tol > 0))
+        return compressLossless(cdata, n, sizeof(Real), out);
+    //
+    // Each value becomes the nearest multiple q*(2*tol).  The differences
+    // of consecutive q are small for smooth data; they are zigzag varint
+    // coded.  The value is rebuilt with one multiplication, so the
+    // reader reproduces it exactly.
+    //
+    const Real twotol = 2*tol;
+    const Real qmax   = 4.e15;  // ---- q is exact as a Real below 2^53
+
+    std::vector<unsigned char> vbytes;
+    vbytes.reserve(2*n);
+
+    long long qprev = 0;
+
+    for (long i = 0; i < n; ++i)
+    {
+        const Real r = data[i] / twotol;
+        if ( ! (std::abs(r) < qmax))
+            return compressLossless(cdata, n, sizeof(Real), out);
+
+        const long long q = std::llround(r);
+        if ( ! (std::abs(q*twotol - data[i]) <= tol))
+            return compressLossless(cdata, n, sizeof(Real), out);
+
+        const long long d = q - qprev;
+        qprev = q;
+
+        uint64_t z = (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+        while (z >= 0x80)
+        {
+            vbytes.push_back(static_cast<unsigned char>(z | 0x80));
+            z >>= 7;
+        }
+        vbytes.push_back(static_cast<unsigned char>(z));
+    }
+
+    const long pos = beginBlock(out);
+
+    out.resize(pos + BlockHeaderBytes + 8);
+    putInt64(&out[pos + BlockHeaderBytes], vbytes.size());
+    if ( ! vbytes.empty())
+        lzCompress(vbytes.data(), vbytes.size(), out);
+
+    if (static_cast<long>(out.size()) - pos - BlockHeaderBytes >= nbytes)
+    {
+        out.resize(pos);
+        return compressLossless(cdata, n, sizeof(Real), out);
+    }
+
+    endBlock(out, pos, ErrorBounded);
+    return ErrorBounded;
+}
+
+long
+FabCompress::payloadBytes (const char* hdr)
+{
+    return getInt64(hdr);
+}
+
+int
+FabCompress::mode (const char* hdr)
+{
+    return hdr[8];
+}
+
+void
+FabCompress::decompress (const char* block, long n, int elemBytes, Real tol,
+                         char* out)
+{
+    const long  nbytes  = n * elemBytes;
+    const long  plen    = payloadBytes(block);
+    const char* payload = block + BlockHeaderBytes;
+
+    switch (mode(block))
+    {
+    case Stored:
+    {
+        if (plen != nbytes)
+            amrex::Error("FabCompress: corrupt block");
+        std::memcpy(out, payload, nbytes);
+        break;
+    }
+    case ShuffleLZ:
+    {
+        std::vector<unsigned char> shuffled(nbytes);
+        lzDecompress(reinterpret_cast<const unsigned char*>(payload), plen,
+                     shuffled.data(), nbytes);
+        for (int b = 0; b < elemBytes; ++b)
+        {
+            const unsigned char* src = &shuffled[0] + b*n;
+            for (long i = 0; i < n; ++i)
+                out[i*elemBytes + b] = src[i];
+        }
+        break;
+    }
+    case ErrorBounded:
+    {
+        BL_ASSERT(elemBytes == sizeof(Real));
+
+        const long vlen = getInt64(payload);
+        std::vector<unsigned char> vbytes(vlen);
+        lzDecompress(reinterpret_cast<const unsigned char*>(payload + 8), plen - 8,
+                     vbytes.data(), vlen);
+
+        const Real twotol = 2*tol;
+        Real* rout = reinterpret_cast<Real*>(out);
+
+        const unsigned char* vp   = vbytes.data();
+        const unsigned char* vend = vp + vlen;
+        long long q = 0;
+
+        for (long i = 0; i < n; ++i)
+        {
+            uint64_t z = 0;
+            int shift = 0;
+            for (;;)
+            {
+                if (vp >= vend)
+                    amrex::Error("FabCompress: corrupt block");
+                const unsigned char c = *vp++;
+                z |= static_cast<uint64_t>(c & 0x7f) << shift;
+                if ( ! (c & 0x80)) break;
+                shift += 7;
+            }
+            q += static_cast<long long>(z >> 1) ^ -static_cast<long long>(z & 1);
+            rout[i] = q*twotol;
+        }
+        break;
+    }
+    default:
+        amrex::Error("FabCompress: unknown block mode");
+    }
+}
+
+void
+FabCompress::readBlock (std::istream& is, std::vector<char>& buf)
+{
+    buf.resize(BlockHeaderBytes);
+    is.read(buf.data(), BlockHeaderBytes);
+    const long plen = payloadBytes(buf.data());
+    buf.resize(BlockHeaderBytes + plen);
+    is.read(buf.data() + BlockHeaderBytes, plen);
+    if ( ! is.good())
+        amrex::Error("FabCompress::readBlock() failed");
+}
+
+void
+FabCompress::skipBlock (std::istream& is)
+{
+    char hdr[BlockHeaderBytes];
+    is.read(hdr, BlockHeaderBytes);
+    is.seekg(payloadBytes(hdr), std::ios::cur);
+    if ( ! is.good())
+        amrex::Error("FabCompress::skipBlock() failed");
+}
+
+}
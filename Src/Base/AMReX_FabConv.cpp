@@ -3,6 +3,8 @@
 #include <cstdlib>
 #include <limits>
 #include <cstring>
+#include <cstdint>
+#include <algorithm>
 
 #include <AMReX.H>
 #include <AMReX_FabConv.H>
@@ -865,6 +867,181 @@ operator>> (std::istream&   is,
     return is;
 }
 
+//
+// Fast paths for conversions between IEEE formats that differ only in
+// byte order and/or float/double width, which is what reading and
+// writing FAB_IEEE_32 and FAB_NATIVE_32 data comes down to.  The loops
+// are simple enough for the compiler to vectorize.  Denormals are
+// flushed to zero where PD_fconvert would do so.
+//
+
+static inline
+uint32_t
+byteswap32 (uint32_t v)
+{
+    return (v >> 24) | ((v >> 8) & 0xff00U) | ((v << 8) & 0xff0000U) | (v << 24);
+}
+
+static inline
+uint64_t
+byteswap64 (uint64_t v)
+{
+    return (uint64_t(byteswap32(uint32_t(v))) << 32) | byteswap32(uint32_t(v >> 32));
+}
+
+//
+// Is rd IEEE float or double in big or little endian byte order?
+//
+
+static
+bool
+ieee_layout (const RealDescriptor& rd,
+             int&                  nbytes,
+             bool&                 bigEndian)
+{
+    const Array<long>& fmt = rd.formatarray();
+    const Array<int>&  ord = rd.orderarray();
+
+    if (fmt.size() != 8) {
+        return false;
+    }
+    if (std::equal(fmt.begin(), fmt.end(), FPC::ieee_float)) {
+        nbytes = 4;
+    } else if (std::equal(fmt.begin(), fmt.end(), FPC::ieee_double)) {
+        nbytes = 8;
+    } else {
+        return false;
+    }
+    if (ord.size() != nbytes) {
+        return false;
+    }
+
+    bool normal(true), reverse(true);
+    for (int i = 0; i < nbytes; ++i) {
+        normal  = normal  && (ord[i] == i + 1);
+        reverse = reverse && (ord[i] == nbytes - i);
+    }
+    bigEndian = normal;
+    return normal || reverse;
+}
+
+static
+bool
+host_is_big_endian ()
+{
+    const uint32_t one(1);
+    unsigned char c;
+    memcpy(&c, &one, 1);
+    return c == 0;
+}
+
+template <typename UINT>
+static
+void
+ieee_swap (void* out, const void* in, long nitems)
+{
+    const char* pin  = static_cast<const char*>(in);
+    char*       pout = static_cast<char*>(out);
+    for (long i = 0; i < nitems; ++i) {
+        UINT v;
+        memcpy(&v, pin + i*sizeof(UINT), sizeof(UINT));
+        v = (sizeof(UINT) == 4) ? UINT(byteswap32(uint32_t(v))) : UINT(byteswap64(uint64_t(v)));
+        memcpy(pout + i*sizeof(UINT), &v, sizeof(UINT));
+    }
+}
+
+template <bool ISWAP, bool OSWAP>
+static
+void
+ieee_widen (void* out, const void* in, long nitems)
+{
+    const char* pin  = static_cast<const char*>(in);
+    char*       pout = static_cast<char*>(out);
+    for (long i = 0; i < nitems; ++i) {
+        uint32_t v;
+        memcpy(&v, pin + 4*i, 4);
+        if (ISWAP) v = byteswap32(v);
+        float f;
+        memcpy(&f, &v, 4);
+        double d = ((v & 0x7f800000U) == 0) ? 0.0 : double(f);
+        uint64_t w;
+        memcpy(&w, &d, 8);
+        if (OSWAP) w = byteswap64(w);
+        memcpy(pout + 8*i, &w, 8);
+    }
+}
+
+template <bool ISWAP, bool OSWAP, bool FIXDENORMALS>
+static
+void
+ieee_narrow (void* out, const void* in, long nitems)
+{
+    const char* pin  = static_cast<const char*>(in);
+    char*       pout = static_cast<char*>(out);
+    for (long i = 0; i < nitems; ++i) {
+        uint64_t v;
+        memcpy(&v, pin + 8*i, 8);
+        if (ISWAP) v = byteswap64(v);
+        double d;
+        memcpy(&d, &v, 8);
+        float f(d);
+        uint32_t w;
+        memcpy(&w, &f, 4);
+        if (FIXDENORMALS && (w & 0x7f800000U) == 0) w = 0;
+        if (OSWAP) w = byteswap32(w);
+        memcpy(pout + 4*i, &w, 4);
+    }
+}
+
+static
+bool
+PD_ieeeconvert (void*                 out,
+                const void*           in,
+                long                  nitems,
+                const RealDescriptor& ord,
+                const RealDescriptor& ird)
+{
+    int  obytes, ibytes;
+    bool obig, ibig;
+    if ( ! ieee_layout(ord, obytes, obig) || ! ieee_layout(ird, ibytes, ibig))
+        return false;
+
+    BL_PROFILE("PD_ieeeconvert");
+
+    static const bool hostBig = host_is_big_endian();
+    const bool iswap(ibig != hostBig);
+    const bool oswap(obig != hostBig);
+
+    if (ibytes == obytes)
+    {
+        if (iswap == oswap) {
+            memcpy(out, in, nitems*ibytes);
+        } else if (ibytes == 4) {
+            ieee_swap<uint32_t>(out, in, nitems);
+        } else {
+            ieee_swap<uint64_t>(out, in, nitems);
+        }
+    }
+    else if (ibytes == 4)
+    {
+        if      ( ! iswap && ! oswap) ieee_widen<false, false>(out, in, nitems);
+        else if (   iswap && ! oswap) ieee_widen<true,  false>(out, in, nitems);
+        else if ( ! iswap &&   oswap) ieee_widen<false, true >(out, in, nitems);
+        else                          ieee_widen<true,  true >(out, in, nitems);
+    }
+    else
+    {
+        //
+        // Native to native 32 has always kept the denormals.
+        //
+        if      ( ! iswap && ! oswap) ieee_narrow<false, false, false>(out, in, nitems);
+        else if (   iswap && ! oswap) ieee_narrow<true,  false, true >(out, in, nitems);
+        else if ( ! iswap &&   oswap) ieee_narrow<false, true,  true >(out, in, nitems);
+        else                          ieee_narrow<true,  true,  true >(out, in, nitems);
+    }
+    return true;
+}
+
 static
 void
 PD_convert (void*                 out,
@@ -883,16 +1060,13 @@ PD_convert (void*                 out,
         BL_ASSERT(int(n) == nitems);
         memcpy(out, in, n*ord.numBytes());
     }
+    else if (boffs == 0 && ! onescmp && PD_ieeeconvert(out, in, nitems, ord, ird))
+    {
+        // ---- done
+    }
     else if (ord.formatarray() == ird.formatarray() && boffs == 0 && ! onescmp) {
         permute_real_word_order(out, in, nitems, ord.order(), ird.order());
     }
-    else if (ird == FPC::NativeRealDescriptor() && ord == FPC::Native32RealDescriptor()) {
-      const Real *rIn = static_cast<const Real *>(in);
-      float *rOut= static_cast<float *>(out);
-      for(long i(0); i < nitems; ++i) {
-        rOut[i] = rIn[i];
-      }
-    }
     else
     {
         PD_fconvert(out, in, nitems, boffs, ord.format(), ord.order(),
@@ -940,6 +1114,19 @@ RealDescriptor::convertToNativeFormat (Real*                 out,
 {
     BL_PROFILE("RD:convertToNativeFormat_is");
 
+    if (id == FPC::NativeRealDescriptor())
+    {
+        is.read(reinterpret_cast<char*>(out), nitems*sizeof(Real));
+        if(bAlwaysFixDenormals) {
+          PD_fixdenormals(out, nitems, FPC::NativeRealDescriptor().format(),
+			  FPC::NativeRealDescriptor().order());
+        }
+        if(is.fail()) {
+          amrex::Error("convert(Real*,long,istream&,RealDescriptor&) failed");
+        }
+        return;
+    }
+
     long buffSize(std::min(long(readBufferSize), nitems));
     char *bufr = new char[buffSize * id.numBytes()];
 
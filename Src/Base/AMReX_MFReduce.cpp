@@ -0,0 +1,241 @@
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <AMReX_MFReduce.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_BLProfiler.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace amrex {
+
+int
+MFReduce::add (OpType type, const MultiFab& x, int xcomp,
+               const MultiFab* y, int ycomp, int ncomp, int nghost)
+{
+    BL_ASSERT(xcomp >= 0 && xcomp + ncomp <= x.nComp());
+    BL_ASSERT(nghost >= 0 && nghost <= x.nGrow());
+    BL_ASSERT(m_ops.empty() || m_ops[0].x->color() == x.color());
+
+    ReduceOp op;
+    op.type   = type;
+    op.x      = &x;
+    op.y      = y;
+    op.xcomp  = xcomp;
+    op.ycomp  = ycomp;
+    op.ncomp  = ncomp;
+    op.nghost = nghost;
+
+    m_ops.push_back(op);
+    m_evaluated = false;
+
+    return m_ops.size() - 1;
+}
+
+int
+MFReduce::addNorm0 (const MultiFab& mf, int comp, int nghost)
+{
+    return add(NORM0, mf, comp, 0, 0, 1, nghost);
+}
+
+int
+MFReduce::addNorm1 (const MultiFab& mf, int comp, int nghost)
+{
+    BL_ASSERT(mf.ixType().cellCentered());
+    return add(NORM1, mf, comp, 0, 0, 1, nghost);
+}
+
+int
+MFReduce::addNorm2 (const MultiFab& mf, int comp)
+{
+    BL_ASSERT(mf.ixType().cellCentered());
+    return add(NORM2, mf, comp, 0, 0, 1, 0);
+}
+
+int
+MFReduce::addSum (const MultiFab& mf, int comp)
+{
+    return add(SUM, mf, comp, 0, 0, 1, 0);
+}
+
+int
+MFReduce::addMin (const MultiFab& mf, int comp, int nghost)
+{
+    return add(MIN, mf, comp, 0, 0, 1, nghost);
+}
+
+int
+MFReduce::addMax (const MultiFab& mf, int comp, int nghost)
+{
+    return add(MAX, mf, comp, 0, 0, 1, nghost);
+}
+
+int
+MFReduce::addDot (const MultiFab& x, int xcomp,
+                  const MultiFab& y, int ycomp,
+                  int numcomp, int nghost)
+{
+    BL_ASSERT(x.boxArray() == y.boxArray());
+    BL_ASSERT(x.DistributionMap() == y.DistributionMap());
+    BL_ASSERT(y.nGrow() >= nghost);
+    BL_ASSERT(ycomp >= 0 && ycomp + numcomp <= y.nComp());
+    return add(DOT, x, xcomp, &y, ycomp, numcomp, nghost);
+}
+
+void
+MFReduce::clear ()
+{
+    m_ops.clear();
+    m_result.clear();
+    m_evaluated = false;
+}
+
+void
+MFReduce::eval (bool local)
+{
+    BL_PROFILE("MFReduce::eval()");
+
+    const int N = m_ops.size();
+    //
+    // The min reductions are done as max reductions of the negated values,
+    // so every result is either a sum or a max.  A max norm is never
+    // negative, so it starts at 0 and a local norm over no boxes is 0.
+    //
+    const Real rmax = std::numeric_limits<Real>::max();
+
+    m_result.resize(N);
+    for (int i = 0; i < N; ++i)
+        m_result[i] = (isSum(m_ops[i].type) || m_ops[i].type == NORM0) ? 0 : -rmax;
+
+#ifdef _OPENMP
+    const int nthreads = omp_get_max_threads();
+#else
+    const int nthreads = 1;
+#endif
+
+    std::vector<bool> done(N, false);
+
+    for (int i = 0; i < N; ++i)
+    {
+        if (done[i]) continue;
+        //
+        // All the reductions over MultiFabs with the same layout as this one.
+        //
+        const MultiFab& mf = *m_ops[i].x;
+
+        std::vector<int> group;
+        for (int j = i; j < N; ++j)
+        {
+            const MultiFab& mfj = *m_ops[j].x;
+            if (!done[j] && (&mfj == &mf ||
+                             (mfj.boxArray() == mf.boxArray() &&
+                              mfj.DistributionMap() == mf.DistributionMap())))
+            {
+                group.push_back(j);
+                done[j] = true;
+            }
+        }
+
+        const int ng = group.size();
+
+        std::vector<std::vector<Real> > priv(nthreads, std::vector<Real>(ng));
+        for (int t = 0; t < nthreads; ++t)
+            for (int k = 0; k < ng; ++k)
+                priv[t][k] = m_result[group[k]];
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+#ifdef _OPENMP
+            const int tid = omp_get_thread_num();
+#else
+            const int tid = 0;
+#endif
+            Real* pv = priv[tid].data();
+
+            for (MFIter mfi(mf,true); mfi.isValid(); ++mfi)
+            {
+                for (int k = 0; k < ng; ++k)
+                {
+                    const ReduceOp& op = m_ops[group[k]];
+                    const FArrayBox& xfab = (*op.x)[mfi];
+                    const Box& bx = mfi.growntilebox(op.nghost);
+
+                    switch (op.type)
+                    {
+                    case NORM0:
+                        pv[k] = std::max(pv[k], xfab.norm(bx, 0, op.xcomp, 1));
+                        break;
+                    case NORM1:
+                        pv[k] += xfab.norm(bx, 1, op.xcomp, 1);
+                        break;
+                    case NORM2:
+                        pv[k] += xfab.dot(bx, op.xcomp, xfab, bx, op.xcomp, 1);
+                        break;
+                    case SUM:
+                        pv[k] += xfab.sum(bx, op.xcomp, 1);
+                        break;
+                    case MIN:
+                        pv[k] = std::max(pv[k], -xfab.min(bx, op.xcomp));
+                        break;
+                    case MAX:
+                        pv[k] = std::max(pv[k], xfab.max(bx, op.xcomp));
+                        break;
+                    case DOT:
+                        pv[k] += xfab.dot(bx, op.xcomp, (*op.y)[mfi], bx, op.ycomp, op.ncomp);
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (int k = 0; k < ng; ++k)
+        {
+            Real& r = m_result[group[k]];
+            if (isSum(m_ops[group[k]].type)) {
+                r = 0;
+                for (int t = 0; t < nthreads; ++t) r += priv[t][k];
+            } else {
+                for (int t = 0; t < nthreads; ++t) r = std::max(r, priv[t][k]);
+            }
+        }
+    }
+
+    if (!local && N > 0)
+    {
+        //
+        // Pack the sums in front of the maxes and reduce them all at once.
+        //
+        std::vector<Real> buf;
+        buf.reserve(N);
+        for (int i = 0; i < N; ++i)
+            if (isSum(m_ops[i].type)) buf.push_back(m_result[i]);
+        const int nsum = buf.size();
+        for (int i = 0; i < N; ++i)
+            if (!isSum(m_ops[i].type)) buf.push_back(m_result[i]);
+
+        ParallelDescriptor::ReduceRealSumMax(buf.data(), nsum, N-nsum, m_ops[0].x->color());
+
+        int isum = 0, imax = nsum;
+        for (int i = 0; i < N; ++i)
+            m_result[i] = isSum(m_ops[i].type) ? buf[isum++] : buf[imax++];
+    }
+
+    for (int i = 0; i < N; ++i)
+    {
+        if (m_ops[i].type == MIN) {
+            m_result[i] = -m_result[i];
+        } else if (m_ops[i].type == NORM2) {
+            m_result[i] = std::sqrt(m_result[i]);
+        }
+    }
+
+    m_evaluated = true;
+}
+
+}
@@ -906,15 +906,24 @@ MultiFab::norm2 (int comp) const
 Real
 MultiFab::norm2 (int comp, const Periodicity& period) const
 {
-    MultiFab tmpmf(boxArray(), DistributionMap(), 1, 0, MFInfo(), Factory());
-    MultiFab::Copy(tmpmf, *this, comp, 0, 1, 0);
+    const OMinfo& om = getOMinfo(period);
 
-    auto mask = OverlapMask(period);
-    MultiFab::Divide(tmpmf, *mask, 0, 0, 1, 0);
+    Real nm2 = 0.e0;
 
-    Real nm2 = MultiFab::Dot(*this, comp, tmpmf, 0, 1, 0);
-    nm2 = std::sqrt(nm2);
-    return nm2;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:nm2)
+#endif
+    for (MFIter mfi(*this,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const FArrayBox* wgt = om.weight(mfi.LocalIndex());
+        nm2 += wgt ? get(mfi).norm(bx, *wgt, 2, comp, 1)
+                   : get(mfi).dot(bx, comp, get(mfi), bx, comp, 1);
+    }
+
+    ParallelDescriptor::ReduceRealSum(nm2,this->color());
+
+    return std::sqrt(nm2);
 }
 
 Array<Real>
@@ -973,13 +982,24 @@ MultiFab::norm2 (const Array<int>& comps) const
 Real
 MultiFab::norm1 (int comp, const Periodicity& period) const
 {
-    MultiFab tmpmf(boxArray(), DistributionMap(), 1, 0, MFInfo(), Factory());
-    MultiFab::Copy(tmpmf, *this, comp, 0, 1, 0);
+    const OMinfo& om = getOMinfo(period);
 
-    auto mask = OverlapMask(period);
-    MultiFab::Divide(tmpmf, *mask, 0, 0, 1, 0);
+    Real nm1 = 0.e0;
 
-    return tmpmf.norm1(0, 0);
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:nm1)
+#endif
+    for (MFIter mfi(*this,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const FArrayBox* wgt = om.weight(mfi.LocalIndex());
+        nm1 += wgt ? get(mfi).norm(bx, *wgt, 1, comp, 1)
+                   : get(mfi).norm(bx, 1, comp, 1);
+    }
+
+    ParallelDescriptor::ReduceRealSum(nm1,this->color());
+
+    return nm1;
 }
 
 Real
@@ -1070,6 +1090,29 @@ MultiFab::sum (int comp, bool local) const
     return sm;
 }
 
+Real
+MultiFab::sum (int comp, const Periodicity& period) const
+{
+    const OMinfo& om = getOMinfo(period);
+
+    Real sm = 0.e0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:sm)
+#endif
+    for (MFIter mfi(*this,true); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        const FArrayBox* wgt = om.weight(mfi.LocalIndex());
+        sm += wgt ? get(mfi).dot(bx, comp, *wgt, bx, 0, 1)
+                  : get(mfi).sum(bx, comp, 1);
+    }
+
+    ParallelDescriptor::ReduceRealSum(sm, this->color());
+
+    return sm;
+}
+
 void
 MultiFab::minus (const MultiFab& mf,
                  int             strt_comp,
@@ -1479,4 +1522,19 @@ MultiFab::AddProcsToComp (int ioProcNumSCS, int ioProcNumAll,
   FabArray<FArrayBox>::AddProcsToComp(ioProcNumSCS, ioProcNumAll, scsMyId, scsComm);
 }
 
+void
+FillBoundary (Array<MultiFab*> const& mf, const Periodicity& period, bool cross)
+{
+    Array<FabArray<FArrayBox>*> fa(mf.begin(), mf.end());
+    FillBoundary(fa, period, cross);
+}
+
+void
+FillBoundary (Array<MultiFab*> const& mf, Array<int> const& scomp, Array<int> const& ncomp,
+              const Periodicity& period, bool cross)
+{
+    Array<FabArray<FArrayBox>*> fa(mf.begin(), mf.end());
+    FillBoundary(fa, scomp, ncomp, period, cross);
+}
+
 }
@@ -116,8 +116,10 @@ void NFilesIter::SetDynamic(int deciderproc)
 
 NFilesIter::NFilesIter(const std::string &filename,
 		       const Array<int> &readranks,
-                       bool setBuf)
+                       bool setBuf,
+                       int readTag)
 {
+  stReadTag = (readTag < 0) ? ParallelDescriptor::MaxTag() : readTag;
   isReading = true;
   myProc    = ParallelDescriptor::MyProc();
   nProcs    = ParallelDescriptor::NProcs();
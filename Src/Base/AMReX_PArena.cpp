@@ -0,0 +1,132 @@
+
+#include <algorithm>
+
+#include <AMReX_PArena.H>
+#include <AMReX_BLassert.H>
+
+namespace amrex {
+
+PArena::PArena (std::size_t min_block_size,
+                std::size_t max_pooled)
+    :
+    m_max_pooled(max_pooled),
+    m_pooled(0),
+    m_used(0),
+    m_used_hwm(0),
+    m_actually_used(0),
+    m_actually_used_hwm(0),
+    m_nalloc(0),
+    m_nreuse(0)
+{
+    m_min_block = Arena::align(min_block_size == 0 ? static_cast<std::size_t>(DefaultMinBlockSize)
+                                                   : min_block_size);
+}
+
+PArena::~PArena ()
+{
+    release();
+
+    for (auto const& kv : m_busylist)
+        ::operator delete(kv.first);
+}
+
+std::size_t
+PArena::bucket_size (std::size_t nbytes) const
+{
+    std::size_t sz = m_min_block;
+    while (sz < nbytes)
+        sz <<= 1;
+    return sz;
+}
+
+void*
+PArena::alloc (std::size_t nbytes)
+{
+    void* vp = 0;
+
+#ifdef _OPENMP
+#pragma omp critical(parena)
+#endif
+    {
+        const std::size_t sz = bucket_size(nbytes);
+
+        ++m_nalloc;
+
+        auto it = m_freelist.find(sz);
+
+        if (it != m_freelist.end() && !it->second.empty())
+        {
+            vp = it->second.back();
+            it->second.pop_back();
+            m_pooled -= sz;
+            ++m_nreuse;
+        }
+        else
+        {
+            vp = ::operator new(sz);
+            m_used += sz;
+            m_used_hwm = std::max(m_used_hwm, m_used);
+        }
+
+        m_busylist[vp] = sz;
+
+        m_actually_used += sz;
+        m_actually_used_hwm = std::max(m_actually_used_hwm, m_actually_used);
+    }
+
+    return vp;
+}
+
+void
+PArena::free (void* vp)
+{
+    if (vp == 0) return;
+
+#ifdef _OPENMP
+#pragma omp critical(parena)
+#endif
+    {
+        auto it = m_busylist.find(vp);
+
+        BL_ASSERT(it != m_busylist.end());
+
+        const std::size_t sz = it->second;
+
+        m_busylist.erase(it);
+
+        if (sz <= m_max_pooled - m_pooled)
+        {
+            m_freelist[sz].push_back(vp);
+            m_pooled += sz;
+        }
+        else
+        {
+            ::operator delete(vp);
+            m_used -= sz;
+        }
+
+        m_actually_used -= sz;
+    }
+}
+
+void
+PArena::release ()
+{
+#ifdef _OPENMP
+#pragma omp critical(parena)
+#endif
+    {
+        for (auto& kv : m_freelist)
+        {
+            for (void* vp : kv.second)
+            {
+                ::operator delete(vp);
+                m_used -= kv.first;
+            }
+        }
+        m_freelist.clear();
+        m_pooled = 0;
+    }
+}
+
+}
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <stack>
 #include <list>
+#include <map>
 #include <chrono>
 
 #include <AMReX_Utility.H>
@@ -95,6 +96,11 @@ namespace ParallelDescriptor
     MPI_Group m_group_all     = MPI_GROUP_NULL;
     MPI_Group m_group_comp    = MPI_GROUP_NULL;
     Array<MPI_Group> m_group_sidecar;
+    //
+    // The op of ReduceRealSumMax and its record types, by record length.
+    //
+    MPI_Op m_sum_max_op = MPI_OP_NULL;
+    std::map<int,MPI_Datatype> m_sum_max_types;
 #else
     //  Set these for non-mpi codes that do not call amrex::Initialize(...)
     int m_MyId_all         = 0;
@@ -128,6 +134,11 @@ namespace ParallelDescriptor
 
     int m_nCommColors = 1;
     int m_clr_map = 0;
+    //
+    // Shared-memory nodes
+    //
+    int m_nNodes = 1;
+    Array<int> m_node_of_rank;
     Color m_MyCommSubColor;
     Color m_MyCommCompColor;
 
@@ -335,6 +346,13 @@ ParallelDescriptor::EndParallel ()
     BL_ASSERT(m_MyId_all   != myId_undefined);
     BL_ASSERT(m_nProcs_all != nProcs_undefined);
 
+    for (auto& t : m_sum_max_types) {
+      BL_MPI_REQUIRE( MPI_Type_free(&t.second) );
+    }
+    m_sum_max_types.clear();
+    if(m_sum_max_op != MPI_OP_NULL) {
+      BL_MPI_REQUIRE( MPI_Op_free(&m_sum_max_op) );
+    }
     if(m_group_comp != MPI_GROUP_NULL && m_group_comp != m_group_all) {
       BL_MPI_REQUIRE( MPI_Group_free(&m_group_comp) );
     }
@@ -760,9 +778,11 @@ ParallelDescriptor::SetNProcsSidecars (const Array<int> &compRanksInAll,
 #endif
 
     ParallelDescriptor::EndTeams();
+    ParallelDescriptor::EndNodes();
     ParallelDescriptor::EndSubCommunicator();
 
     ParallelDescriptor::StartTeams();
+    ParallelDescriptor::StartNodes();
     ParallelDescriptor::StartSubCommunicator();
 
 
@@ -1111,6 +1131,88 @@ ParallelDescriptor::ReduceRealMin (Array<std::reference_wrapper<Real> >&& rvar,
     }
 }
 
+namespace
+{
+    //
+    // The user op behind ReduceRealSumMax.  Each element of the datatype
+    // holds the number of summed entries, the summed entries and then the
+    // maxed entries.  Since the whole record is one element, MPI never
+    // hands us a piece of it.
+    //
+    void
+    SumMaxOp (void* invec, void* inoutvec, int* len, MPI_Datatype* dtype)
+    {
+        int nbytes;
+        MPI_Type_size(*dtype, &nbytes);
+        const int n = nbytes / sizeof(Real);
+
+        for (int k = 0; k < *len; ++k)
+        {
+            const Real* in    = static_cast<const Real*>(invec)    + k*n;
+            Real*       inout = static_cast<Real*>      (inoutvec) + k*n;
+            const int nsum = static_cast<int>(in[0]);
+            for (int i = 1; i <= nsum; ++i)
+                inout[i] += in[i];
+            for (int i = nsum+1; i < n; ++i)
+                inout[i] = std::max(inout[i], in[i]);
+        }
+    }
+}
+
+void
+ParallelDescriptor::ReduceRealSumMax (Real* r, int nsum, int nmax, Color color)
+{
+    if (nmax == 0) {
+        if (nsum > 0) ReduceRealSum(r,nsum,color);
+        return;
+    } else if (nsum == 0) {
+        ReduceRealMax(r,nmax,color);
+        return;
+    }
+
+    if (!isActive(color)) return;
+
+#ifdef BL_USE_UPCXX
+    Mode.set_mpi_mode();
+#endif
+
+#ifdef BL_LAZY
+    Lazy::EvalReduction();
+#endif
+
+    BL_PROFILE_S("ParallelDescriptor::ReduceRealSumMax()");
+    BL_COMM_PROFILE_ALLREDUCE(BLProfiler::AllReduceR, BLProfiler::BeforeCall(), true);
+
+    const int cnt = nsum + nmax + 1;
+
+    Array<Real> send(cnt), recv(cnt);
+    send[0] = nsum;
+    std::copy(r, r+nsum+nmax, send.begin()+1);
+
+    //
+    // The op and the types are freed in EndParallel.
+    //
+    if (m_sum_max_op == MPI_OP_NULL) {
+        BL_MPI_REQUIRE( MPI_Op_create(SumMaxOp, 1, &m_sum_max_op) );
+    }
+
+    auto it = m_sum_max_types.find(cnt);
+    if (it == m_sum_max_types.end()) {
+        MPI_Datatype t;
+        BL_MPI_REQUIRE( MPI_Type_contiguous(cnt, Mpi_typemap<Real>::type(), &t) );
+        BL_MPI_REQUIRE( MPI_Type_commit(&t) );
+        it = m_sum_max_types.insert(std::make_pair(cnt, t)).first;
+    }
+    const MPI_Datatype rec_type = it->second;
+
+    BL_MPI_REQUIRE( MPI_Allreduce(send.dataPtr(), recv.dataPtr(), 1, rec_type, m_sum_max_op,
+                                  Communicator(color)) );
+
+    BL_COMM_PROFILE_ALLREDUCE(BLProfiler::AllReduceR, cnt * sizeof(Real), false);
+
+    std::copy(recv.begin()+1, recv.end(), r);
+}
+
 void
 ParallelDescriptor::ReduceIntSum (int& r, Color color)
 {
@@ -2296,6 +2398,8 @@ void ParallelDescriptor::ReduceRealSum (Array<std::reference_wrapper<Real> >&& r
 void ParallelDescriptor::ReduceRealMax (Array<std::reference_wrapper<Real> >&& rvar, int cpu) {}
 void ParallelDescriptor::ReduceRealMin (Array<std::reference_wrapper<Real> >&& rvar, int cpu) {}
 
+void ParallelDescriptor::ReduceRealSumMax (Real*,int,int,Color) {}
+
 void ParallelDescriptor::ReduceLongAnd (long&,Color) {}
 void ParallelDescriptor::ReduceLongSum (long&,Color) {}
 void ParallelDescriptor::ReduceLongMax (long&,Color) {}
@@ -2738,6 +2842,47 @@ ParallelDescriptor::EndTeams ()
     m_Team.clear();
 }
 
+void
+ParallelDescriptor::StartNodes ()
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    m_node_of_rank.resize(nprocs);
+    std::fill(m_node_of_rank.begin(), m_node_of_rank.end(), 0);
+    m_nNodes = 1;
+
+#if defined(BL_USE_MPI) && (MPI_VERSION >= 3)
+    //
+    // Each process learns the lowest rank on its node, and the node ids
+    // are then numbered in the order of those lowest ranks.
+    //
+    MPI_Comm node_comm;
+    BL_MPI_REQUIRE( MPI_Comm_split_type(ParallelDescriptor::Communicator(), MPI_COMM_TYPE_SHARED,
+                                        ParallelDescriptor::MyProc(), MPI_INFO_NULL, &node_comm) );
+    int node_lead = ParallelDescriptor::MyProc();
+    BL_MPI_REQUIRE( MPI_Allreduce(MPI_IN_PLACE, &node_lead, 1, MPI_INT, MPI_MIN, node_comm) );
+    BL_MPI_REQUIRE( MPI_Comm_free(&node_comm) );
+
+    BL_MPI_REQUIRE( MPI_Allgather(&node_lead, 1, MPI_INT, m_node_of_rank.dataPtr(), 1, MPI_INT,
+                                  ParallelDescriptor::Communicator()) );
+
+    Array<int> node_id(nprocs, -1);
+    m_nNodes = 0;
+    for (int i = 0; i < nprocs; ++i)
+    {
+        if (m_node_of_rank[i] == i) node_id[i] = m_nNodes++;
+        m_node_of_rank[i] = node_id[m_node_of_rank[i]];
+    }
+#endif
+}
+
+void
+ParallelDescriptor::EndNodes ()
+{
+    m_node_of_rank.clear();
+    m_nNodes = 1;
+}
+
 
 bool
 ParallelDescriptor::MPIOneSided ()
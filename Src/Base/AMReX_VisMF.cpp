@@ -5,7 +5,19 @@
 #include <sstream>
 #include <vector>
 #include <deque>
+#include <numeric>
+#include <algorithm>
 #include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <AMReX_ccse-mpi.H>
 #include <AMReX_Utility.H>
@@ -13,12 +25,15 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_NFiles.H>
 #include <AMReX_FPC.H>
+#include <AMReX_FabCompress.H>
+#include <AMReX_FabChecksum.H>
 
 namespace amrex {
 
 static const char *TheMultiFabHdrFileSuffix = "_H";
 static const char *FabFileSuffix = "_D_";
 static const char *TheFabOnDiskPrefix = "FabOnDisk:";
+static const char *TheChecksumsPrefix = "Checksums:";
 
 std::map<std::string, VisMF::PersistentIFStream> VisMF::persistentIFStreams;
 
@@ -32,6 +47,13 @@ bool VisMF::checkFilePositions(false);
 bool VisMF::usePersistentIFStreams(false);
 bool VisMF::useSynchronousReads(false);
 bool VisMF::useDynamicSetSelection(true);
+bool VisMF::asyncWrite(false);
+bool VisMF::useMemoryMap(false);
+VisMF::Codec VisMF::codec(VisMF::LosslessCodec);
+Real VisMF::codecTolerance(0.0);
+bool VisMF::writeChecksums(false);
+std::string VisMF::dedupPrevDir;
+std::string VisMF::dedupDir;
 
 long VisMF::ioBufferSize(VisMF::IO_Buffer_Size);
 
@@ -45,6 +67,119 @@ int VisMF::nMFFileInStreams(1);
 namespace
 {
     bool initialized = false;
+
+    //
+    // The staged data of one AsyncWrite() on this processor.
+    //
+    struct AsyncWriteJob
+    {
+        std::string       fileName;
+        long              offset;
+        std::vector<char> data;
+        long              fileSize;  // ---- > 0 if this processor sets the file size
+    };
+
+    //
+    // A region of one on-disk fab read by ReadSubregion() on this processor.
+    //
+    struct SubregionRead
+    {
+        int  dstIndex;  // ---- the fab in the destination FabArray
+        int  srcIndex;  // ---- the fab on disk
+        Box  region;
+    };
+    //
+    // The bytes in a data file of a contiguous chunk of one component
+    // of a SubregionRead:  a row, or a plane or more if the region
+    // covers the whole fab in the lower directions.
+    //
+    struct SubregionSpan
+    {
+        long start, end;
+        int  read, comp;
+        Box  chunk;
+    };
+
+    std::thread                 asyncThread;
+    std::mutex                  asyncMutex;
+    std::condition_variable     asyncCV;
+    std::deque<AsyncWriteJob *> asyncQueue;
+    bool                        asyncBusy(false);
+    bool                        asyncStop(false);
+    bool                        asyncPending(false);
+    std::string                 asyncError;
+
+    inline bool
+    IsDuplicate (const Array<VisMF::FabOnDisk> &dupFod, int i)
+    {
+        return ! dupFod.empty() && ! dupFod[i].m_name.empty();
+    }
+
+    void
+    AsyncWriteOne (const AsyncWriteJob &job)
+    {
+        int fd(::open(job.fileName.c_str(), O_WRONLY | O_CREAT, 0666));
+        if(fd < 0) {
+          std::lock_guard<std::mutex> lock(asyncMutex);
+          asyncError = "VisMF::AsyncWrite:  cannot open " + job.fileName + ":  " + strerror(errno);
+          return;
+        }
+        const char *p(job.data.data());
+        long remaining(job.data.size()), pos(job.offset);
+        while(remaining > 0) {
+          ssize_t nw(::pwrite(fd, p, remaining, pos));
+          if(nw < 0) {
+            if(errno == EINTR) {
+              continue;
+            }
+            std::lock_guard<std::mutex> lock(asyncMutex);
+            asyncError = "VisMF::AsyncWrite:  write to " + job.fileName + " failed:  " + strerror(errno);
+            break;
+          }
+          p += nw;
+          pos += nw;
+          remaining -= nw;
+        }
+        if(job.fileSize > 0 && ::ftruncate(fd, job.fileSize) != 0) {
+          std::lock_guard<std::mutex> lock(asyncMutex);
+          asyncError = "VisMF::AsyncWrite:  cannot size " + job.fileName + ":  " + strerror(errno);
+        }
+        ::close(fd);
+    }
+
+    void
+    AsyncWriteThread ()
+    {
+        std::unique_lock<std::mutex> lock(asyncMutex);
+        for(;;) {
+          asyncCV.wait(lock, [] { return asyncStop || ! asyncQueue.empty(); });
+          if(asyncQueue.empty()) {
+            return;
+          }
+          AsyncWriteJob *job = asyncQueue.front();
+          asyncQueue.pop_front();
+          asyncBusy = true;
+          lock.unlock();
+
+          AsyncWriteOne(*job);
+          delete job;
+
+          lock.lock();
+          asyncBusy = false;
+          asyncCV.notify_all();
+        }
+    }
+
+    // ---- wait for this processor's writes, returns the first error if any
+    std::string
+    AsyncWriteWait ()
+    {
+        std::unique_lock<std::mutex> lock(asyncMutex);
+        asyncCV.wait(lock, [] { return asyncQueue.empty() && ! asyncBusy; });
+        std::string err;
+        std::swap(err, asyncError);
+        return err;
+    }
 }
 
 void
@@ -82,6 +217,21 @@ VisMF::Initialize ()
     pp.query("usesynchronousreads", useSynchronousReads);
     pp.query("usedynamicsetselection", useDynamicSetSelection);
     pp.query("iobuffersize", ioBufferSize);
+    pp.query("asyncwrite", asyncWrite);
+    pp.query("usememorymap", useMemoryMap);
+
+    std::string codecName;
+    if(pp.query("codec", codecName)) {
+      if(codecName == "lossless") {
+        codec = VisMF::LosslessCodec;
+      } else if(codecName == "errorbounded") {
+        codec = VisMF::ErrorBoundedCodec;
+      } else {
+        amrex::Abort("VisMF::Initialize:  vismf.codec must be lossless or errorbounded");
+      }
+    }
+    pp.query("codectolerance", codecTolerance);
+    pp.query("checksums", writeChecksums);
 
     initialized = true;
 }
@@ -89,6 +239,21 @@ VisMF::Initialize ()
 void
 VisMF::Finalize ()
 {
+    if(asyncThread.joinable()) {
+      std::string err(AsyncWriteWait());
+      if( ! err.empty()) {
+        amrex::Warning(err.c_str());
+      }
+      {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+        asyncStop = true;
+      }
+      asyncCV.notify_all();
+      asyncThread.join();
+      asyncStop = false;
+    }
+    asyncPending = false;
+
     initialized = false;
 }
 
@@ -110,6 +275,20 @@ VisMF::GetNOutFiles()
     return nOutFiles;
 }
 
+void
+VisMF::SetDedupDirectories (const std::string &prevDir,
+                            const std::string &dir)
+{
+    dedupPrevDir = prevDir;
+    dedupDir     = dir;
+    while(dedupPrevDir.size() > 1 && dedupPrevDir[dedupPrevDir.size() - 1] == '/') {
+      dedupPrevDir.erase(dedupPrevDir.size() - 1);
+    }
+    while(dedupDir.size() > 1 && dedupDir[dedupDir.size() - 1] == '/') {
+      dedupDir.erase(dedupDir.size() - 1);
+    }
+}
+
 std::ostream&
 operator<< (std::ostream&           os,
             const VisMF::FabOnDisk& fod)
@@ -278,7 +457,8 @@ operator<< (std::ostream        &os,
     os << hd.m_fod      << '\n';
 
     if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       os << hd.m_min      << '\n';
       os << hd.m_max      << '\n';
@@ -310,6 +490,20 @@ operator<< (std::ostream        &os,
       }
     }
 
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+      os << hd.m_writtenRD << '\n';
+      os << hd.m_codec << ' ' << hd.m_codec_tol << '\n';
+    }
+
+    if( ! hd.m_checksum.empty()) {
+      BL_ASSERT(hd.m_checksum.size() == hd.m_fod.size());
+      BL_ASSERT(hd.m_fabBytes.size() == hd.m_fod.size());
+      os << TheChecksumsPrefix << '\n';
+      for(int i(0); i < hd.m_checksum.size(); ++i) {
+        os << std::hex << hd.m_checksum[i] << std::dec << ' ' << hd.m_fabBytes[i] << '\n';
+      }
+    }
+
     os.flags(oflags);
     os.precision(oldPrec);
 
@@ -352,7 +546,8 @@ operator>> (std::istream  &is,
     BL_ASSERT(hd.m_ba.size() == hd.m_fod.size());
 
     if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       is >> hd.m_min;
       is >> hd.m_max;
@@ -384,11 +579,35 @@ operator>> (std::istream  &is,
       is >> hd.m_writtenRD;
     }
 
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+      is >> hd.m_writtenRD;
+      is >> hd.m_codec >> hd.m_codec_tol;
+    }
 
     if( ! is.good()) {
         amrex::Error("Read of VisMF::Header failed");
     }
 
+    // ---- the optional fab checksums come last, older readers stop before them
+    hd.m_checksum.clear();
+    hd.m_fabBytes.clear();
+    is >> std::ws;
+    if(is.peek() == TheChecksumsPrefix[0]) {
+      std::string str;
+      is >> str;
+      if(str != TheChecksumsPrefix) {
+        amrex::Error("Expected Checksums: when reading VisMF::Header");
+      }
+      hd.m_checksum.resize(hd.m_fod.size());
+      hd.m_fabBytes.resize(hd.m_fod.size());
+      for(int i(0); i < hd.m_checksum.size(); ++i) {
+        is >> std::hex >> hd.m_checksum[i] >> std::dec >> hd.m_fabBytes[i];
+      }
+      if(is.fail()) {
+        amrex::Error("Read of VisMF::Header checksums failed");
+      }
+    }
+
     return is;
 }
 
@@ -498,7 +717,7 @@ VisMF::GetFab (int fabIndex,
                int ncomp) const
 {
     if(m_pa[ncomp][fabIndex] == 0) {
-        m_pa[ncomp][fabIndex] = VisMF::readFAB(fabIndex, m_fafabname, m_hdr, ncomp);
+        m_pa[ncomp][fabIndex] = const_cast<VisMF*>(this)->readFAB(fabIndex, ncomp);
     }
     return *m_pa[ncomp][fabIndex];
 }
@@ -531,6 +750,11 @@ FArrayBox*
 VisMF::readFAB (int                idx,
                 const std::string& mf_name)
 {
+    if(mf_name == m_fafabname) {
+      if(FArrayBox *fab = mapFAB(idx, -1)) {
+        return fab;
+      }
+    }
     return VisMF::readFAB(idx, mf_name, m_hdr, -1);
 }
 
@@ -538,9 +762,96 @@ FArrayBox*
 VisMF::readFAB (int idx,
 		int ncomp)
 {
+    if(FArrayBox *fab = mapFAB(idx, ncomp)) {
+      return fab;
+    }
     return VisMF::readFAB(idx, m_fafabname, m_hdr, ncomp);
 }
 
+FArrayBox*
+VisMF::mapFAB (int fabIndex,
+               int whichComp) const
+{
+    if( ! useMemoryMap || m_hdr.m_vers == Header::Compressed_v1) {
+      return nullptr;
+    }
+    if(NoFabHeader(m_hdr) && m_hdr.m_writtenRD != FPC::NativeRealDescriptor()) {
+      return nullptr;
+    }
+
+    std::string FullName(VisMF::DirName(m_fafabname));
+    FullName += m_hdr.m_fod[fabIndex].m_name;
+
+    auto mfIter = m_mappedFiles.find(FullName);
+    if(mfIter == m_mappedFiles.end()) {
+      // ---- private and writable, so aliasing fabs can be changed in memory
+      char *addr(nullptr);
+      long length(0);
+      int fd(::open(FullName.c_str(), O_RDONLY));
+      if(fd >= 0) {
+        struct stat st;
+        if(::fstat(fd, &st) == 0 && st.st_size > 0) {
+          void *p = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+          if(p != MAP_FAILED) {
+            addr   = static_cast<char *> (p);
+            length = st.st_size;
+          }
+        }
+        ::close(fd);
+      }
+      if(addr == nullptr && verbose) {
+        std::cout << ParallelDescriptor::MyProc() << "::VisMF::mapFAB:  could not map "
+                  << FullName << ", reading it instead" << std::endl;
+      }
+      mfIter = m_mappedFiles.insert(std::make_pair(FullName, std::make_pair(addr, length))).first;
+    }
+
+    char *addr(mfIter->second.first);
+    const long length(mfIter->second.second);
+    if(addr == nullptr) {
+      return nullptr;
+    }
+
+    Box fab_box(m_hdr.m_ba[fabIndex]);
+    if(m_hdr.m_ngrow) {
+      fab_box.grow(m_hdr.m_ngrow);
+    }
+
+    long head(m_hdr.m_fod[fabIndex].m_head);
+    if(m_hdr.m_vers == Header::Version_v1) {
+      // ---- only fabs written in the native format are mapped
+      std::ostringstream hss;
+      hss << "FAB " << FPC::NativeRealDescriptor() << fab_box << ' ' << m_hdr.m_ncomp << '\n';
+      const std::string &fabHeader = hss.str();
+      if(head + static_cast<long>(fabHeader.size()) > length ||
+         fabHeader.compare(0, fabHeader.size(), addr + head, fabHeader.size()) != 0)
+      {
+        return nullptr;
+      }
+      head += fabHeader.size();
+    }
+
+    const long compBytes(fab_box.numPts() * sizeof(Real));
+    if(head + compBytes * m_hdr.m_ncomp > length) {
+      return nullptr;
+    }
+
+    char *data = addr + head;
+    int ncomp(m_hdr.m_ncomp);
+    if(whichComp != -1) {
+      data += whichComp * compBytes;
+      ncomp = 1;
+    }
+
+    if(reinterpret_cast<uintptr_t>(data) % alignof(Real) == 0) {
+      return new FArrayBox(fab_box, ncomp, reinterpret_cast<Real *> (data));
+    }
+    // ---- the fab header left the data unaligned, copy it
+    FArrayBox *fab = new FArrayBox(fab_box, ncomp);
+    memcpy(fab->dataPtr(), data, compBytes * ncomp);
+    return fab;
+}
+
 std::string
 VisMF::BaseName (const std::string& filename)
 {
@@ -617,7 +928,9 @@ VisMF::Write (const FArrayBox&   fab,
 
 VisMF::Header::Header ()
     :
-    m_vers(VisMF::Header::Undefined_v1)
+    m_vers(VisMF::Header::Undefined_v1),
+    m_codec(VisMF::LosslessCodec),
+    m_codec_tol(0.0)
 {}
 
 //
@@ -634,10 +947,29 @@ VisMF::Header::Header (const FabArray<FArrayBox>& mf,
     m_ncomp(mf.nComp()),
     m_ngrow(mf.nGrow()),
     m_ba(mf.boxArray()),
-    m_fod(m_ba.size())
+    m_fod(m_ba.size()),
+    m_codec(VisMF::LosslessCodec),
+    m_codec_tol(0.0)
 {
     BL_PROFILE("VisMF::Header");
 
+    if(version == Compressed_v1) {
+      m_codec     = VisMF::GetCodec();
+      m_codec_tol = VisMF::GetCodecTolerance();
+      // ---- the error bounded codec works on native Reals
+      if(m_codec == VisMF::ErrorBoundedCodec ||
+         FArrayBox::getFormat() == FABio::FAB_NATIVE)
+      {
+        m_writtenRD = FPC::NativeRealDescriptor();
+      } else if(FArrayBox::getFormat() == FABio::FAB_NATIVE_32) {
+        m_writtenRD = FPC::Native32RealDescriptor();
+      } else if(FArrayBox::getFormat() == FABio::FAB_IEEE_32) {
+        m_writtenRD = FPC::Ieee32NormalRealDescriptor();
+      } else {
+        amrex::Error("VisMF::Header:  Compressed_v1 requires FAB_NATIVE, FAB_NATIVE_32 or FAB_IEEE_32");
+      }
+    }
+
     if(version == NoFabHeader_v1) {
       m_min.clear();
       m_max.clear();
@@ -920,6 +1252,13 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
         }
     }
 
+    if(asyncWrite && FArrayBox::getFormat() != FABio::FAB_ASCII &&
+                     FArrayBox::getFormat() != FABio::FAB_8BIT)
+    {
+      delete whichRD;
+      return VisMF::AsyncWrite(mf, mf_name);
+    }
+
     int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
     long bytesWritten(0);
     bool calcMinMax(false);
@@ -930,16 +1269,53 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
     NFilesIter nfi(nOutFiles, filePrefix, groupSets, setBuf);
 
     bool oldHeader(currentVersion == VisMF::Header::Version_v1);
+    bool compressed(currentVersion == VisMF::Header::Compressed_v1);
+
+    // ---- compress before waiting for a turn to write
+    Array< std::vector<char> > compressedFabs;
+    if(compressed) {
+      VisMF::CompressFabs(mf, hdr, compressedFabs);
+    }
+
+    // ---- the checksums tell which fabs the dedup directories already have
+    Array<VisMF::FabOnDisk> dupFod;
+    if((writeChecksums || ! dedupDir.empty()) &&
+       FArrayBox::getFormat() != FABio::FAB_ASCII &&
+       FArrayBox::getFormat() != FABio::FAB_8BIT)
+    {
+      VisMF::ChecksumFabs(mf, hdr, *whichRD, compressedFabs);
+      VisMF::FindDuplicateFabs(mf_name, hdr, *whichRD, dupFod);
+    }
 
       if(useDynamicSetSelection) {
         nfi.SetDynamic();
       }
       for( ; nfi.ReadyToWrite(); ++nfi) {
+	  if(compressed) {
+	    // ---- the offsets are gathered in FindOffsets
+	    long filePosition(VisMF::FileOffset(nfi.Stream()));
+	    const std::string fileName(VisMF::BaseName(nfi.FileName()));
+            for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+	      if(IsDuplicate(dupFod, mfi.index())) {
+	        continue;
+	      }
+	      const std::vector<char> &blocks = compressedFabs[mfi.LocalIndex()];
+	      hdr.m_fod[mfi.index()] = VisMF::FabOnDisk(fileName, filePosition);
+              nfi.Stream().write(blocks.data(), blocks.size());
+	      filePosition += blocks.size();
+	      bytesWritten += blocks.size();
+	    }
+            nfi.Stream().flush();
+	    continue;
+	  }
 	  // ---- find the total number of bytes including fab headers if needed
           const FABio &fio = FArrayBox::getFABio();
           int whichRDBytes(whichRD->numBytes()), nFABs(0);
           long writeDataItems(0), writeDataSize(0);
           for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+	    if(IsDuplicate(dupFod, mfi.index())) {
+	      continue;
+	    }
 	    const FArrayBox &fab = mf[mfi];
 	    if(oldHeader) {
 	      std::stringstream hss;
@@ -963,6 +1339,9 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 	  if(canCombineFABs) {
             long writePosition(0);
             for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+              if(IsDuplicate(dupFod, mfi.index())) {
+                continue;
+              }
               int hLength(0);
               const FArrayBox &fab = mf[mfi];
 	      writeDataItems = fab.box().numPts() * mf.nComp();
@@ -989,6 +1368,9 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 
 	  } else {    // ---- write fabs individually
             for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+              if(IsDuplicate(dupFod, mfi.index())) {
+                continue;
+              }
               int hLength(0);
               const FArrayBox &fab = mf[mfi];
 	      writeDataItems = fab.box().numPts() * mf.nComp();
@@ -1022,13 +1404,20 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
     }
 
     if(currentVersion == VisMF::Header::Version_v1 ||
-       currentVersion == VisMF::Header::NoFabHeaderMinMax_v1)
+       currentVersion == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       currentVersion == VisMF::Header::Compressed_v1)
     {
       hdr.CalculateMinMax(mf, coordinatorProc);
     }
 
     VisMF::FindOffsets(mf, filePrefix, hdr, groupSets, currentVersion,
-		       useDynamicSetSelection, nfi);
+		       useDynamicSetSelection, nfi, dupFod);
+
+    for(int i(0); i < dupFod.size(); ++i) {
+      if(IsDuplicate(dupFod, i)) {
+        hdr.m_fod[i] = dupFod[i];
+      }
+    }
 
     bytesWritten += VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
 
@@ -1038,6 +1427,201 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 }
 
 
+long
+VisMF::AsyncWrite (const FabArray<FArrayBox> &mf,
+                   const std::string &mf_name)
+{
+    BL_PROFILE("VisMF::AsyncWrite()");
+    BL_ASSERT(mf_name[mf_name.length() - 1] != '/');
+    BL_ASSERT(currentVersion != VisMF::Header::Undefined_v1);
+
+    RealDescriptor *whichRD(nullptr);
+    if(FArrayBox::getFormat() == FABio::FAB_NATIVE) {
+      whichRD = FPC::NativeRealDescriptor().clone();
+    } else if(FArrayBox::getFormat() == FABio::FAB_NATIVE_32) {
+      whichRD = FPC::Native32RealDescriptor().clone();
+    } else if(FArrayBox::getFormat() == FABio::FAB_IEEE_32) {
+      whichRD = FPC::Ieee32NormalRealDescriptor().clone();
+    } else {
+      amrex::Abort("VisMF::AsyncWrite:  FAB_ASCII and FAB_8BIT are not supported");
+    }
+    bool doConvert(*whichRD != FPC::NativeRealDescriptor());
+
+    const int myProc(ParallelDescriptor::MyProc());
+    const int nProcs(ParallelDescriptor::NProcs());
+    const int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
+    const int nFiles(NFilesIter::ActualNFiles(nOutFiles));
+    const int whichRDBytes(whichRD->numBytes());
+    const int nComps(mf.nComp());
+    const bool oldHeader(currentVersion == VisMF::Header::Version_v1);
+    const bool compressed(currentVersion == VisMF::Header::Compressed_v1);
+    const FABio &fio = FArrayBox::getFABio();
+    const BoxArray &mfBA = mf.boxArray();
+    const Array<int> &pmap = mf.DistributionMap().ProcessorMap();
+
+    bool calcMinMax(false);
+    VisMF::Header hdr(mf, VisMF::NFiles, currentVersion, calcMinMax);
+
+    if(currentVersion == VisMF::Header::Version_v1 ||
+       currentVersion == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       currentVersion == VisMF::Header::Compressed_v1)
+    {
+      hdr.CalculateMinMax(mf, coordinatorProc);
+    }
+
+    std::string filePrefix(mf_name + FabFileSuffix);
+    //
+    // ---- The offsets of the static set selection:  the ranks sharing
+    // ---- a file write one after the other in increasing rank order, and
+    // ---- each rank writes its fabs in increasing index order.
+    //
+    Array<long> fabBytes(mfBA.size(), 0);
+    Array<long> rankBytes(nProcs, 0);
+    Array< std::vector<char> > compressedFabs;
+    if(compressed) {
+      // ---- the compressed sizes are known only to the owners
+      VisMF::CompressFabs(mf, hdr, compressedFabs);
+      for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        fabBytes[mfi.index()] = compressedFabs[mfi.LocalIndex()].size();
+      }
+      ParallelDescriptor::ReduceLongSum(fabBytes.dataPtr(), fabBytes.size());
+    }
+
+    Array<VisMF::FabOnDisk> dupFod;
+    if(writeChecksums || ! dedupDir.empty()) {
+      VisMF::ChecksumFabs(mf, hdr, *whichRD, compressedFabs);
+      VisMF::FindDuplicateFabs(mf_name, hdr, *whichRD, dupFod);
+    }
+
+    for(int i(0); i < mfBA.size(); ++i) {
+      if(IsDuplicate(dupFod, i)) {
+        fabBytes[i] = 0;  // ---- the data are in the previous write
+        continue;
+      }
+      if(compressed) {
+        rankBytes[pmap[i]] += fabBytes[i];
+        continue;
+      }
+      if(oldHeader) {
+        std::stringstream hss;
+        FArrayBox tempFab(mf.fabbox(i), nComps, false);  // ---- no alloc
+        fio.write_header(hss, tempFab, tempFab.nComp());
+        fabBytes[i] = hss.tellp();
+      }
+      fabBytes[i] += mf.fabbox(i).numPts() * nComps * whichRDBytes;
+      rankBytes[pmap[i]] += fabBytes[i];
+    }
+
+    Array<long> rankOffset(nProcs, 0);
+    Array<long> fileSize(nFiles, 0);
+    Array<int>  lastRankInFile(nFiles, -1);
+    for(int rank(0); rank < nProcs; ++rank) {
+      int fileNumber(NFilesIter::FileNumber(nFiles, rank, groupSets));
+      rankOffset[rank] = fileSize[fileNumber];
+      fileSize[fileNumber] += rankBytes[rank];
+      lastRankInFile[fileNumber] = rank;
+    }
+
+    Array<long> rankPosition(rankOffset);
+    for(int i(0); i < mfBA.size(); ++i) {
+      if(IsDuplicate(dupFod, i)) {
+        hdr.m_fod[i] = dupFod[i];
+        continue;
+      }
+      int fileNumber(NFilesIter::FileNumber(nFiles, pmap[i], groupSets));
+      hdr.m_fod[i].m_name = VisMF::BaseName(NFilesIter::FileName(fileNumber, filePrefix));
+      hdr.m_fod[i].m_head = rankPosition[pmap[i]];
+      rankPosition[pmap[i]] += fabBytes[i];
+    }
+
+    long bytesWritten(VisMF::WriteHeader(mf_name, hdr, coordinatorProc));
+    //
+    // ---- Stage this rank's fabs exactly as Write() would put them in the file.
+    //
+    const int myFileNumber(NFilesIter::FileNumber(nFiles, myProc, groupSets));
+
+    AsyncWriteJob *job = new AsyncWriteJob;
+    job->fileName = NFilesIter::FileName(myFileNumber, filePrefix);
+    job->offset   = rankOffset[myProc];
+    job->fileSize = (lastRankInFile[myFileNumber] == myProc) ? fileSize[myFileNumber] : 0;
+    job->data.resize(rankBytes[myProc]);
+
+    long writePosition(0);
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+      if(IsDuplicate(dupFod, mfi.index())) {
+        continue;
+      }
+      const FArrayBox &fab = mf[mfi];
+      char *afPtr = job->data.data() + writePosition;
+      if(compressed) {
+        const std::vector<char> &blocks = compressedFabs[mfi.LocalIndex()];
+        memcpy(afPtr, blocks.data(), blocks.size());
+        std::vector<char>().swap(compressedFabs[mfi.LocalIndex()]);
+        writePosition += fabBytes[mfi.index()];
+        continue;
+      }
+      int hLength(0);
+      if(oldHeader) {
+        std::stringstream hss;
+        fio.write_header(hss, fab, fab.nComp());
+        hLength = hss.tellp();
+        memcpy(afPtr, hss.str().c_str(), hLength);  // ---- the fab header
+      }
+      long writeDataItems(fab.box().numPts() * nComps);
+      if(doConvert) {
+        RealDescriptor::convertFromNativeFormat(static_cast<void *> (afPtr + hLength),
+                                                writeDataItems,
+                                                fab.dataPtr(), *whichRD);
+      } else {
+        memcpy(afPtr + hLength, fab.dataPtr(), writeDataItems * whichRDBytes);
+      }
+      writePosition += fabBytes[mfi.index()];
+    }
+    BL_ASSERT(writePosition == rankBytes[myProc]);
+
+    bytesWritten += rankBytes[myProc];
+
+    {
+      std::lock_guard<std::mutex> lock(asyncMutex);
+      asyncQueue.push_back(job);
+    }
+    if( ! asyncThread.joinable()) {
+      asyncThread = std::thread(AsyncWriteThread);
+    }
+    asyncCV.notify_all();
+
+    asyncPending = true;
+
+    delete whichRD;
+
+    return bytesWritten;
+}
+
+
+void
+VisMF::AsyncWriteFence ()
+{
+    //
+    // ---- All processors take part in every AsyncWrite(), so
+    // ---- asyncPending is the same everywhere.
+    //
+    if( ! asyncPending) {
+      return;
+    }
+
+    BL_PROFILE("VisMF::AsyncWriteFence()");
+
+    std::string err(AsyncWriteWait());
+    if( ! err.empty()) {
+      amrex::Error(err.c_str());
+    }
+
+    ParallelDescriptor::Barrier("VisMF::AsyncWriteFence");
+
+    asyncPending = false;
+}
+
+
 void
 VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
 		    const std::string &filePrefix,
@@ -1045,7 +1629,8 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
 		    bool groupSets,
 		    VisMF::Header::Version whichVersion,
 		    bool useDynamicSetSelection,
-		    NFilesIter &nfi)
+		    NFilesIter &nfi,
+		    const Array<VisMF::FabOnDisk> &dupFod)
 {
     BL_PROFILE("VisMF::FindOffsets");
 
@@ -1057,8 +1642,10 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
     }
 
     if(FArrayBox::getFormat() == FABio::FAB_ASCII ||
-       FArrayBox::getFormat() == FABio::FAB_8BIT)
+       FArrayBox::getFormat() == FABio::FAB_8BIT  ||
+       whichVersion == VisMF::Header::Compressed_v1)
     {
+      // ---- the fab sizes are not known here, gather the offsets
 #ifdef BL_USE_MPI
     Array<int> nmtags(nProcs,0);
     Array<int> offset(nProcs,0);
@@ -1109,11 +1696,18 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
     if(myProc == coordinatorProc) {
         Array<int> cnt(nProcs,0);
 
+        Array<int> fileNumbers;
+        if(whichVersion == VisMF::Header::Compressed_v1 && useDynamicSetSelection) {
+          fileNumbers = nfi.FileNumbersWritten();
+        }
+
         for(int j(0), N(mf.size()); j < N; ++j) {
             const int i(pmap[j]);
             hdr.m_fod[j].m_head = recvdata[offset[i]+cnt[i]];
 
-            const std::string name(NFilesIter::FileName(nOutFiles, filePrefix, i, groupSets));
+            const std::string name(fileNumbers.empty()
+                                   ? NFilesIter::FileName(nOutFiles, filePrefix, i, groupSets)
+                                   : NFilesIter::FileName(fileNumbers[i], filePrefix));
 
             hdr.m_fod[j].m_name = VisMF::BaseName(name);
 
@@ -1183,6 +1777,9 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
 	      whichFileName   = VisMF::BaseName(NFilesIter::FileName(whichFileNumber, filePrefix));
 
 	      for(int i(0); i < index.size(); ++i) {
+	        if(IsDuplicate(dupFod, index[i])) {
+	          continue;
+	        }
 	        hdr.m_fod[index[i]].m_name = whichFileName;
 	        hdr.m_fod[index[i]].m_head = currentOffset[whichFileNumber];
 	        currentOffset[whichFileNumber] += mf.fabbox(index[i]).numPts() * nComps * whichRDBytes
@@ -1258,6 +1855,11 @@ VisMF::VisMF (const std::string &fafab_name)
 
 VisMF::~VisMF ()
 {
+    for(auto &mapped : m_mappedFiles) {
+      if(mapped.second.first != nullptr) {
+        ::munmap(mapped.second.first, mapped.second.second);
+      }
+    }
 }
 
 
@@ -1281,7 +1883,13 @@ VisMF::readFAB (int                  idx,
     std::ifstream *infs = VisMF::OpenStream(FullName);
     infs->seekg(hdr.m_fod[idx].m_head, std::ios::beg);
 
-    if(hdr.m_vers == Header::Version_v1) {
+    if(hdr.m_vers == Header::Compressed_v1) {
+      if(whichComp == -1) {    // ---- read all components
+        VisMF::ReadCompressedFab(*infs, *fab, 0, 0, hdr.m_ncomp, hdr);
+      } else {
+        VisMF::ReadCompressedFab(*infs, *fab, whichComp, 0, 1, hdr);
+      }
+    } else if(hdr.m_vers == Header::Version_v1) {
       if(whichComp == -1) {    // ---- read all components
         fab->readFrom(*infs);
       } else {
@@ -1331,7 +1939,9 @@ VisMF::readFAB (FabArray<FArrayBox> &mf,
     std::ifstream *infs = VisMF::OpenStream(FullName);
     infs->seekg(hdr.m_fod[idx].m_head, std::ios::beg);
 
-    if(NoFabHeader(hdr)) {
+    if(hdr.m_vers == Header::Compressed_v1) {
+      VisMF::ReadCompressedFab(*infs, fab, 0, 0, hdr.m_ncomp, hdr);
+    } else if(NoFabHeader(hdr)) {
       if(hdr.m_writtenRD == FPC::NativeRealDescriptor()) {
         infs->read((char *) fab.dataPtr(), fab.nBytes());
       } else {
@@ -1347,6 +1957,532 @@ VisMF::readFAB (FabArray<FArrayBox> &mf,
 }
 
 
+void
+VisMF::CompressFabs (const FabArray<FArrayBox> &mf,
+                     const VisMF::Header &hdr,
+                     Array< std::vector<char> > &blocks)
+{
+    BL_PROFILE("VisMF::CompressFabs");
+
+    const RealDescriptor &rd = hdr.m_writtenRD;
+    const bool errorBounded(hdr.m_codec == VisMF::ErrorBoundedCodec);
+    const bool doConvert(rd != FPC::NativeRealDescriptor());
+    const int  nComps(mf.nComp());
+
+    blocks.clear();
+    blocks.resize(mf.local_size());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int li = 0; li < mf.local_size(); ++li) {
+      const FArrayBox &fab = mf[mf.IndexArray()[li]];
+      const long nPts(fab.box().numPts());
+      Array<char> cData(doConvert ? nPts * rd.numBytes() : 0);
+      for(int n(0); n < nComps; ++n) {
+        if(errorBounded) {
+          FabCompress::compressErrorBounded(fab.dataPtr(n), nPts, hdr.m_codec_tol, blocks[li]);
+        } else if(doConvert) {
+          RealDescriptor::convertFromNativeFormat(static_cast<void *> (cData.dataPtr()),
+                                                  nPts, fab.dataPtr(n), rd);
+          FabCompress::compressLossless(cData.dataPtr(), nPts, rd.numBytes(), blocks[li]);
+        } else {
+          FabCompress::compressLossless(reinterpret_cast<const char *> (fab.dataPtr(n)),
+                                        nPts, sizeof(Real), blocks[li]);
+        }
+      }
+    }
+}
+
+
+void
+VisMF::ChecksumFabs (const FabArray<FArrayBox> &mf,
+                     VisMF::Header &hdr,
+                     const RealDescriptor &whichRD,
+                     const Array< std::vector<char> > &compressedFabs)
+{
+    BL_PROFILE("VisMF::ChecksumFabs");
+
+    const bool compressed(hdr.m_vers == VisMF::Header::Compressed_v1);
+    const bool oldHeader(hdr.m_vers == VisMF::Header::Version_v1);
+    const bool doConvert(whichRD != FPC::NativeRealDescriptor());
+    const int  nFabs(mf.size());
+    const FABio &fio = FArrayBox::getFABio();
+    //
+    // ---- Only the owner of a fab sets its entries, so the sums are the
+    // ---- values.  [0, nFabs) are the checksums, [nFabs, 2*nFabs) the sizes.
+    //
+    Array<long> sums(2*nFabs, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(int li = 0; li < mf.local_size(); ++li) {
+      const int idx(mf.IndexArray()[li]);
+      const FArrayBox &fab = mf[idx];
+      FabChecksum fc;
+      long nBytes(0);
+      if(compressed) {
+        const std::vector<char> &blocks = compressedFabs[li];
+        fc.update(blocks.data(), blocks.size());
+        nBytes = blocks.size();
+      } else {
+        if(oldHeader) {
+          std::stringstream hss;
+          fio.write_header(hss, fab, fab.nComp());
+          const std::string fabHeader(hss.str());
+          fc.update(fabHeader.data(), fabHeader.size());
+          nBytes += fabHeader.size();
+        }
+        const long nItems(fab.box().numPts() * fab.nComp());
+        if(doConvert) {
+          // ---- convert in pieces, the conversion is item by item
+          const long chunkItems(std::max(1L, ioBufferSize / whichRD.numBytes()));
+          Array<char> cData(std::min(chunkItems, nItems) * whichRD.numBytes());
+          for(long i(0); i < nItems; i += chunkItems) {
+            const long n(std::min(chunkItems, nItems - i));
+            RealDescriptor::convertFromNativeFormat(static_cast<void *> (cData.dataPtr()),
+                                                    n, fab.dataPtr() + i, whichRD);
+            fc.update(cData.dataPtr(), n * whichRD.numBytes());
+          }
+        } else {
+          fc.update(fab.dataPtr(), nItems * sizeof(Real));
+        }
+        nBytes += nItems * whichRD.numBytes();
+      }
+      sums[idx]         = static_cast<long>(fc.value());
+      sums[nFabs + idx] = nBytes;
+    }
+
+    ParallelDescriptor::ReduceLongSum(sums.dataPtr(), sums.size());
+
+    hdr.m_checksum.resize(nFabs);
+    hdr.m_fabBytes.resize(nFabs);
+    for(int i(0); i < nFabs; ++i) {
+      hdr.m_checksum[i] = static_cast<uint64_t>(sums[i]);
+      hdr.m_fabBytes[i] = sums[nFabs + i];
+    }
+}
+
+
+int
+VisMF::FindDuplicateFabs (const std::string &mf_name,
+                          const VisMF::Header &hdr,
+                          const RealDescriptor &whichRD,
+                          Array<VisMF::FabOnDisk> &dupFod)
+{
+    dupFod.clear();
+
+    const std::string dirPrefix(dedupDir + '/');
+    if(dedupDir.empty() || dedupPrevDir.empty() || dedupPrevDir == dedupDir ||
+       mf_name.compare(0, dirPrefix.size(), dirPrefix) != 0)
+    {
+      return 0;
+    }
+
+    BL_PROFILE("VisMF::FindDuplicateFabs");
+
+    const std::string subName(mf_name.substr(dirPrefix.size()));
+    const std::string refName(dedupPrevDir + '/' + subName);
+
+    Array<char> fileCharPtr;
+    ParallelDescriptor::ReadAndBcastFile(refName + TheMultiFabHdrFileSuffix, fileCharPtr, false);
+    if(fileCharPtr.empty()) {
+      return 0;
+    }
+
+    VisMF::Header ref;
+    {
+      std::string fileCharPtrString(fileCharPtr.dataPtr());
+      std::istringstream infs(fileCharPtrString, std::istringstream::in);
+      infs >> ref;
+    }
+
+    //
+    // ---- The bytes of the fabs must be read the same way with either header.
+    //
+    if(ref.m_checksum.empty() || ref.m_vers != hdr.m_vers ||
+       ref.m_ncomp != hdr.m_ncomp || ref.m_ngrow != hdr.m_ngrow ||
+       ref.m_ba.size() != hdr.m_ba.size())
+    {
+      return 0;
+    }
+    if(NoFabHeader(hdr) && ref.m_writtenRD != whichRD) {
+      return 0;
+    }
+    if(hdr.m_vers == VisMF::Header::Compressed_v1) {
+      // ---- the tolerance as the header will have it
+      std::stringstream tss;
+      tss.setf(std::ios::floatfield, std::ios::scientific);
+      tss.precision(16);
+      tss << hdr.m_codec_tol;
+      Real tol(0.0);
+      tss >> tol;
+      if(ref.m_writtenRD != hdr.m_writtenRD || ref.m_codec != hdr.m_codec ||
+         (hdr.m_codec == VisMF::ErrorBoundedCodec && ref.m_codec_tol != tol))
+      {
+        return 0;
+      }
+    }
+
+    //
+    // ---- The data of prevDir/sub/name are reached from the directory of
+    // ---- dir/sub/name through one ../ for each directory of dir/sub/.
+    //
+    std::string prefix("../");
+    for(std::string::size_type i(0); i < subName.size(); ++i) {
+      if(subName[i] == '/') {
+        prefix += "../";
+      }
+    }
+    prefix += VisMF::BaseName(dedupPrevDir) + '/' + VisMF::DirName(subName);
+
+    dupFod.resize(hdr.m_ba.size());
+
+    int nDup(0);
+    for(int i(0); i < hdr.m_ba.size(); ++i) {
+      if(ref.m_ba[i] == hdr.m_ba[i] && ref.m_checksum[i] == hdr.m_checksum[i] &&
+         ref.m_fabBytes[i] == hdr.m_fabBytes[i])
+      {
+        // ---- data the previous write found in an earlier one are at the same depth
+        const VisMF::FabOnDisk &fod = ref.m_fod[i];
+        const bool relative(fod.m_name.compare(0, 3, "../") == 0);
+        dupFod[i] = VisMF::FabOnDisk(relative ? fod.m_name : prefix + fod.m_name, fod.m_head);
+        ++nDup;
+      }
+    }
+
+    if(verbose && ParallelDescriptor::IOProcessor()) {
+      std::cout << "VisMF::FindDuplicateFabs:  " << nDup << " of " << hdr.m_ba.size()
+                << " fabs of " << mf_name << " are in " << refName << std::endl;
+    }
+
+    return nDup;
+}
+
+void
+VisMF::ReadCompressedFab (std::istream &is,
+                          FArrayBox &fab,
+                          int scomp,
+                          int dcomp,
+                          int ncomp,
+                          const VisMF::Header &hdr)
+{
+    BL_PROFILE("VisMF::ReadCompressedFab");
+
+    const RealDescriptor &rd = hdr.m_writtenRD;
+    const bool isNative(rd == FPC::NativeRealDescriptor());
+    const long nPts(fab.box().numPts());
+
+    for(int n(0); n < scomp; ++n) {
+      FabCompress::skipBlock(is);
+    }
+
+    std::vector<char> block;
+    Array<char> cData(isNative ? 0 : nPts * rd.numBytes());
+    for(int n(0); n < ncomp; ++n) {
+      FabCompress::readBlock(is, block);
+      if(isNative) {
+        FabCompress::decompress(block.data(), nPts, sizeof(Real), hdr.m_codec_tol,
+                                reinterpret_cast<char *> (fab.dataPtr(dcomp + n)));
+      } else {
+        FabCompress::decompress(block.data(), nPts, rd.numBytes(), hdr.m_codec_tol,
+                                cData.dataPtr());
+        RealDescriptor::convertToNativeFormat(fab.dataPtr(dcomp + n), nPts,
+                                              static_cast<void *> (cData.dataPtr()), rd);
+      }
+    }
+}
+
+
+void
+VisMF::ReadSubregion (FabArray<FArrayBox> &mf,
+                      const std::string   &mf_name,
+                      int                  scomp,
+                      int                  dcomp,
+                      int                  ncomp,
+                      const char          *faHeader)
+{
+    BL_PROFILE("VisMF::ReadSubregion()");
+
+    readRegions(mf, mf_name, scomp, dcomp, ncomp, faHeader, false);
+}
+
+
+void
+VisMF::ReadChopped (FabArray<FArrayBox> &mf,
+                    const std::string   &mf_name,
+                    const char          *faHeader)
+{
+    BL_PROFILE("VisMF::ReadChopped()");
+
+    readRegions(mf, mf_name, 0, 0, mf.nComp(), faHeader, true);
+}
+
+
+void
+VisMF::readRegions (FabArray<FArrayBox> &mf,
+                    const std::string   &mf_name,
+                    int                  scomp,
+                    int                  dcomp,
+                    int                  ncomp,
+                    const char          *faHeader,
+                    bool                 chopped)
+{
+    VisMF::AsyncWriteFence();
+
+    VisMF::Header hdr;
+    const int myProc(ParallelDescriptor::MyProc());
+
+    {
+        std::string fileCharPtrString;
+	if(faHeader == nullptr) {
+          Array<char> fileCharPtr;
+          ParallelDescriptor::ReadAndBcastFile(mf_name + TheMultiFabHdrFileSuffix, fileCharPtr);
+          fileCharPtrString = fileCharPtr.dataPtr();
+	} else {
+          fileCharPtrString = faHeader;
+	}
+        std::istringstream infs(fileCharPtrString, std::istringstream::in);
+
+        infs >> hdr;
+    }
+
+    if(scomp < 0 || ncomp < 0 || scomp + ncomp > hdr.m_ncomp ||
+       dcomp < 0 || dcomp + ncomp > mf.nComp())
+    {
+      amrex::Abort("VisMF::readRegions:  bad component range");
+    }
+    if(hdr.m_ba.ixType() != mf.boxArray().ixType()) {
+      amrex::Abort("VisMF::readRegions:  index types do not match");
+    }
+
+    const BoxArray &mfBA = mf.boxArray();
+    const DistributionMapping &mfDM = mf.DistributionMap();
+    //
+    // ---- Every rank can tell which ranks need each file, so the
+    // ---- read order is known without any messages.
+    //
+    std::map<std::string, Array<SubregionRead> > myReads;   // ---- [filename, reads]
+    std::map<std::string, std::set<int> > readFileRanks;     // ---- [filename, ranks]
+    std::vector< std::pair<int,Box> > isects;
+
+    for(int i(0); i < mfBA.size(); ++i) {
+      hdr.m_ba.intersections(mfBA[i], isects);
+      if(chopped) {
+        // ---- the whole fab, ghost cells included, comes from the on-disk
+        // ---- fab that contains it.  nodal and face centered pieces also
+        // ---- touch the neighboring on-disk boxes on their shared faces.
+        int src(-1);
+        for(int ii(0), N(isects.size()); ii < N; ++ii) {
+          if(hdr.m_ba[isects[ii].first].contains(mfBA[i])) {
+            src = isects[ii].first;
+            break;
+          }
+        }
+        if(src < 0) {
+          amrex::Abort("VisMF::ReadChopped:  boxes are not pieces of the on-disk boxes");
+        }
+        isects.resize(1);
+        isects[0].first  = src;
+        isects[0].second = amrex::grow(mfBA[i], mf.nGrow()) & amrex::grow(hdr.m_ba[src], hdr.m_ngrow);
+      }
+      for(int ii(0), N(isects.size()); ii < N; ++ii) {
+        const std::string &fileName = hdr.m_fod[isects[ii].first].m_name;
+        readFileRanks[fileName].insert(mfDM[i]);
+        if(mfDM[i] == myProc) {
+          SubregionRead sr = { i, isects[ii].first, isects[ii].second };
+          myReads[fileName].push_back(sr);
+        }
+      }
+    }
+
+    const int  readTag(ParallelDescriptor::SeqNum());
+    const long maxGap(ioBufferSize);        // ---- read through gaps smaller than this
+    const long maxGroup(16 * ioBufferSize);  // ---- but do not buffer more than this
+    const bool compressed(hdr.m_vers == Header::Compressed_v1);
+
+    for(auto rfrIter = readFileRanks.begin(); rfrIter != readFileRanks.end(); ++rfrIter) {
+      const std::string &fileName = rfrIter->first;
+      std::set<int> &rfrSplitSet = rfrIter->second;
+      if(rfrSplitSet.find(myProc) == rfrSplitSet.end()) {
+        continue;
+      }
+      // ---- at most nMFFileInStreams ranks read a file at a time
+      int ssSize(rfrSplitSet.size());
+      int nStreams(std::min(ssSize, nMFFileInStreams));
+      int ranksPerStream(ssSize / nStreams);
+      Array<int> readRanks;
+      int sIndex(0), sCount(0);
+      for(auto setIter = rfrSplitSet.begin(); setIter != rfrSplitSet.end(); ++setIter) {
+        readRanks.push_back(*setIter);
+	if(++sCount >= ranksPerStream && sIndex < nStreams - 1) {
+	  if(std::find(readRanks.begin(), readRanks.end(), myProc) != readRanks.end()) {
+	    break;
+	  }
+	  readRanks.clear();
+	  sCount = 0;
+	  ++sIndex;
+	}
+      }
+
+      Array<SubregionRead> &reads = myReads[fileName];
+      std::string fullFileName(VisMF::DirName(mf_name) + fileName);
+
+      for(NFilesIter nfi(fullFileName, readRanks, false, readTag); nfi.ReadyToRead(); ++nfi) {
+        std::istream &is = nfi.Stream();
+        //
+        // ---- Find where the data of each fab starts and its format.
+        // ---- Fabs that can not be read in pieces are read whole here.
+        //
+        std::map<int, std::pair<long, RealDescriptor> > srcLayout;  // ---- [srcIndex, (start, rd)]
+        std::map<int, FArrayBox*> srcWhole;                          // ---- [srcIndex, fab]
+
+        for(int r(0); r < reads.size(); ++r) {
+          const int src(reads[r].srcIndex);
+          if(srcLayout.count(src) > 0 || srcWhole.count(src) > 0) {
+            continue;
+          }
+          Box fab_box(hdr.m_ba[src]);
+          fab_box.grow(hdr.m_ngrow);
+          const long head(hdr.m_fod[src].m_head);
+
+          if(NoFabHeader(hdr)) {
+            srcLayout[src] = std::make_pair(head, hdr.m_writtenRD);
+            continue;
+          }
+          if( ! compressed) {
+            // ---- parse the fab header, "FAB rd box ncomp"
+            std::string fabHeader;
+            is.seekg(head, std::ios::beg);
+            std::getline(is, fabHeader);
+            std::istringstream hss(fabHeader);
+            std::string fab;
+            hss >> fab;
+            if(fab == "FAB") {    // ---- not the old "FAB:" format
+              RealDescriptor rd;
+              Box bx;
+              int nvar;
+              hss >> rd >> bx >> nvar;
+              if(hss && bx == fab_box && nvar == hdr.m_ncomp) {
+                srcLayout[src] = std::make_pair(head + static_cast<long>(fabHeader.size()) + 1, rd);
+                continue;
+              }
+            }
+          }
+          FArrayBox *whole = new FArrayBox(fab_box, ncomp);
+          if(compressed) {
+            is.seekg(head, std::ios::beg);
+            VisMF::ReadCompressedFab(is, *whole, scomp, 0, ncomp, hdr);
+          } else {
+            for(int n(0); n < ncomp; ++n) {
+              FArrayBox one;
+              is.seekg(head, std::ios::beg);
+              one.readFrom(is, scomp + n);
+              whole->copy(one, 0, n, 1);
+            }
+          }
+          srcWhole[src] = whole;
+        }
+        //
+        // ---- The byte ranges of the pieces, sorted by position.
+        //
+        std::vector<SubregionSpan> spans;
+        for(int r(0); r < reads.size(); ++r) {
+          const SubregionRead &sr = reads[r];
+          auto swIter = srcWhole.find(sr.srcIndex);
+          if(swIter != srcWhole.end()) {
+            mf[sr.dstIndex].copy(*swIter->second, sr.region, 0, sr.region, dcomp, ncomp);
+            continue;
+          }
+          Box fab_box(hdr.m_ba[sr.srcIndex]);
+          fab_box.grow(hdr.m_ngrow);
+          const std::pair<long, RealDescriptor> &layout = srcLayout[sr.srcIndex];
+          const long nBytes(layout.second.numBytes());
+          // ---- the chunks are contiguous through direction cdir
+          int cdir(0);
+          while(cdir < BL_SPACEDIM - 1 && sr.region.length(cdir) == fab_box.length(cdir)) {
+            ++cdir;
+          }
+          Box chunkStarts(sr.region);
+          long chunkPts(1);
+          for(int d(0); d <= cdir; ++d) {
+            chunkStarts.setBig(d, sr.region.smallEnd(d));
+            chunkPts *= sr.region.length(d);
+          }
+          for(int n(0); n < ncomp; ++n) {
+            const long compStart(layout.first + (scomp + n) * fab_box.numPts() * nBytes);
+            for(IntVect iv(chunkStarts.smallEnd()); iv <= chunkStarts.bigEnd(); chunkStarts.next(iv)) {
+              const long start(compStart + fab_box.index(iv) * nBytes);
+              Box chunk(sr.region);
+              for(int d(cdir + 1); d < BL_SPACEDIM; ++d) {
+                chunk.setSmall(d, iv[d]);
+                chunk.setBig(d, iv[d]);
+              }
+              SubregionSpan span = { start, start + chunkPts * nBytes, r, n, chunk };
+              spans.push_back(span);
+            }
+          }
+        }
+        for(auto swIter = srcWhole.begin(); swIter != srcWhole.end(); ++swIter) {
+          delete swIter->second;
+        }
+        std::sort(spans.begin(), spans.end(), [] (const SubregionSpan &a, const SubregionSpan &b)
+                                                { return a.start < b.start; } );
+        //
+        // ---- Read groups of nearby spans with one read each.
+        //
+        std::vector<char> buffer;
+        for(int first(0), last(0), nSpans(spans.size()); first < nSpans; first = last) {
+          long groupEnd(spans[first].end);
+          for(last = first + 1; last < nSpans; ++last) {
+            if(spans[last].start > groupEnd + maxGap ||
+               std::max(groupEnd, spans[last].end) - spans[first].start > maxGroup)
+            {
+              break;
+            }
+            groupEnd = std::max(groupEnd, spans[last].end);
+          }
+          const long groupStart(spans[first].start);
+          buffer.resize(groupEnd - groupStart);
+          is.seekg(groupStart, std::ios::beg);
+          is.read(buffer.data(), buffer.size());
+          if( ! is.good()) {
+            amrex::Error("VisMF::readRegions:  read failed");
+          }
+
+          for(int sp(first); sp < last; ++sp) {
+            const SubregionRead &sr = reads[spans[sp].read];
+            const RealDescriptor &rd = srcLayout[sr.srcIndex].second;
+            const bool doConvert(rd != FPC::NativeRealDescriptor());
+            const long nBytes(rd.numBytes());
+            Box fab_box(hdr.m_ba[sr.srcIndex]);
+            fab_box.grow(hdr.m_ngrow);
+            FArrayBox &dfab = mf[sr.dstIndex];
+            Real *dst = dfab.dataPtr(dcomp + spans[sp].comp);
+            const Box &chunk = spans[sp].chunk;
+            const char *src = buffer.data() + (spans[sp].start - groupStart);
+            const long base(fab_box.index(chunk.smallEnd()));
+            const long nx(chunk.length(0));
+            // ---- copy row by row
+            Box rows(chunk);
+            rows.setBig(0, chunk.smallEnd(0));
+            for(IntVect iv(rows.smallEnd()); iv <= rows.bigEnd(); rows.next(iv)) {
+              const char *row = src + (fab_box.index(iv) - base) * nBytes;
+              if(doConvert) {
+                RealDescriptor::convertToNativeFormat(dst + dfab.box().index(iv), nx,
+                                                      const_cast<char *> (row), rd);
+              } else {
+                memcpy(dst + dfab.box().index(iv), row, nx * sizeof(Real));
+              }
+            }
+          }
+        }
+      }
+    }
+}
+
+
 void
 VisMF::Read (FabArray<FArrayBox> &mf,
              const std::string   &mf_name,
@@ -1355,6 +2491,8 @@ VisMF::Read (FabArray<FArrayBox> &mf,
 {
     BL_PROFILE("VisMF::Read()");
 
+    VisMF::AsyncWriteFence();
+
     VisMF::Header hdr;
     Real hEndTime, hStartTime, faCopyTime(0.0);
     Real startTime(ParallelDescriptor::second());
@@ -1403,6 +2541,7 @@ VisMF::Read (FabArray<FArrayBox> &mf,
 
     // ---- This code is only for reading in file order
     bool doConvert(hdr.m_writtenRD != FPC::NativeRealDescriptor());
+    int readTag(ParallelDescriptor::SeqNum());
 
     // ---- Create an ordered map of which processors read which
     // ---- Fabs in each file
@@ -1513,7 +2652,7 @@ VisMF::Read (FabArray<FArrayBox> &mf,
 	  frcIter = FileReadChains.find(fileName);
 	  BL_ASSERT(frcIter != FileReadChains.end());
           Array<FabReadLink> &frc = frcIter->second;
-          for(NFilesIter nfi(fullFileName, readRanks); nfi.ReadyToRead(); ++nfi) {
+          for(NFilesIter nfi(fullFileName, readRanks, false, readTag); nfi.ReadyToRead(); ++nfi) {
 
 	      // ---- confirm the data is contiguous in the stream
 	      long firstOffset(-1);
@@ -1895,11 +3034,95 @@ VisMF::Check (const std::string& mf_name)
 }
 
 
+int
+VisMF::VerifyChecksums (const std::string &mf_name)
+{
+    BL_PROFILE("VisMF::VerifyChecksums()");
+
+    VisMF::Header hdr;
+    {
+      Array<char> fileCharPtr;
+      ParallelDescriptor::ReadAndBcastFile(mf_name + TheMultiFabHdrFileSuffix, fileCharPtr);
+      std::string fileCharPtrString(fileCharPtr.dataPtr());
+      std::istringstream infs(fileCharPtrString, std::istringstream::in);
+      infs >> hdr;
+    }
+
+    if(hdr.m_checksum.empty()) {
+      return -1;
+    }
+
+    const int myProc(ParallelDescriptor::MyProc());
+    const int nProcs(ParallelDescriptor::NProcs());
+    const int nFabs(hdr.m_fod.size());
+    //
+    // ---- Each processor reads a run of the fabs sorted by file and offset,
+    // ---- the fabs whose middle byte falls in its share of the total.
+    //
+    Array<int> order(nFabs);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&hdr] (int a, int b)
+              {
+                const VisMF::FabOnDisk &fa = hdr.m_fod[a], &fb = hdr.m_fod[b];
+                return (fa.m_name != fb.m_name) ? fa.m_name < fb.m_name : fa.m_head < fb.m_head;
+              });
+
+    const double totalBytes(std::accumulate(hdr.m_fabBytes.begin(), hdr.m_fabBytes.end(), 0.0));
+    const std::string dirName(VisMF::DirName(mf_name));
+
+    std::string openName;
+    std::ifstream ifs;
+    Array<char> buffer;
+    double startBytes(0.0);
+    int nBad(0);
+
+    for(int k(0); k < nFabs; ++k) {
+      const int i(order[k]);
+      const double middle(startBytes + 0.5 * hdr.m_fabBytes[i]);
+      startBytes += hdr.m_fabBytes[i];
+      const int reader((totalBytes > 0.0) ? std::min(nProcs - 1, static_cast<int> (middle / totalBytes * nProcs))
+                                          : k % nProcs);
+      if(reader != myProc) {
+        continue;
+      }
+
+      const VisMF::FabOnDisk &fod = hdr.m_fod[i];
+      const std::string fileName(dirName + fod.m_name);
+      if(fileName != openName) {
+        ifs.close();
+        ifs.clear();
+        ifs.open(fileName.c_str(), std::ios::in | std::ios::binary);
+        openName = fileName;
+      }
+
+      buffer.resize(hdr.m_fabBytes[i]);
+      ifs.seekg(fod.m_head, std::ios::beg);
+      ifs.read(buffer.dataPtr(), buffer.size());
+
+      bool ok(ifs.good());
+      if(ok) {
+        FabChecksum fc;
+        fc.update(buffer.dataPtr(), buffer.size());
+        ok = (fc.value() == hdr.m_checksum[i]);
+      }
+      if( ! ok) {
+        ++nBad;
+        ifs.clear();
+        std::cout << myProc << "::VisMF::VerifyChecksums:  bad fab " << i << " of " << mf_name
+                  << " in " << fileName << " at " << fod.m_head << std::endl;
+      }
+    }
+
+    ParallelDescriptor::ReduceIntSum(nBad);
+
+    return nBad;
+}
+
 void
 VisMF::clear (int fabIndex)
 {
     for(int ncomp(0), N(m_pa.size()); ncomp < N; ++ncomp) {
-        clear(ncomp, fabIndex);
+        clear(fabIndex, ncomp);
     }
 }
 
@@ -1908,7 +3131,7 @@ VisMF::clear ()
 {
     for(int ncomp(0), N(m_pa.size()); ncomp < N; ++ncomp) {
         for(int fabIndex(0), M(m_pa[ncomp].size()); fabIndex < M; ++fabIndex) {
-            clear(ncomp, fabIndex);
+            clear(fabIndex, ncomp);
         }
     }
 }
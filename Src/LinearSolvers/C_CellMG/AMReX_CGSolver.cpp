@@ -10,6 +10,7 @@
 #include <AMReX_CGSolver.H>
 #include <AMReX_MultiGrid.H>
 #include <AMReX_VisMF.H>
+#include <AMReX_MFReduce.H>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -156,6 +157,21 @@ norm_inf (const MultiFab& res, bool local = false)
     return res.norm0(0,0,local);
 }
 
+//
+// The max norms of res and sol with a single reduction.
+//
+static
+void
+norm_inf (const MultiFab& res, Real& rnorm, const MultiFab& sol, Real& snorm)
+{
+    MFReduce red;
+    const int ir = red.addNorm0(res);
+    const int is = red.addNorm0(sol);
+    red.eval();
+    rnorm = red[ir];
+    snorm = red[is];
+}
+
 int
 CGSolver::solve (MultiFab&       sol,
                  const MultiFab& rhs,
@@ -942,7 +958,11 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
         sxay(sol, sol,  alpha, ph);
         sxay(s,     r, -alpha,  v);
 
+#ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
         rnorm = norm_inf(s);
+#else
+        norm_inf(s, rnorm, sol, sol_norm);
+#endif
 
         if ( verbose > 2 && ParallelDescriptor::IOProcessor(color()) )
         {
@@ -956,7 +976,6 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
 #ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
         if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
 #else
-        sol_norm = norm_inf(sol);
         if ( rnorm < eps_rel*(Lp_norm*sol_norm + rnorm0 ) || rnorm < eps_abs ) break;
 #endif
         if ( use_mg_precond )
@@ -975,13 +994,14 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
         }
         Lp.apply(t, sh, lev, temp_bc_mode);
         //
-        // This is a little funky.  I want to elide one of the reductions
-        // in the following two dotxy()s.  We do that by calculating the "local"
-        // values and then reducing the two local values at the same time.
+        // Compute the two dot products in one pass with one reduction.
         //
-        Real vals[2] = { dotxy(t,t,true), dotxy(t,s,true) };
+        MFReduce red;
+        const int itt = red.addDot(t,0,t,0);
+        const int its = red.addDot(t,0,s,0);
+        red.eval();
 
-        ParallelDescriptor::ReduceRealSum(vals,2,color());
+        Real vals[2] = { red[itt], red[its] };
 
         if ( vals[0] )
 	{
@@ -994,7 +1014,11 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
         sxay(sol, sol,  omega, sh);
         sxay(r,     s, -omega,  t);
 
+#ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
         rnorm = norm_inf(r);
+#else
+        norm_inf(r, rnorm, sol, sol_norm);
+#endif
 
         if ( verbose > 2 && ParallelDescriptor::IOProcessor(color()) )
         {
@@ -1008,7 +1032,6 @@ CGSolver::solve_bicgstab (MultiFab&       sol,
 #ifdef CG_USE_OLD_CONVERGENCE_CRITERIA
         if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
 #else
-        sol_norm = norm_inf(sol);
         if ( rnorm < eps_rel*(Lp_norm*sol_norm + rnorm0 ) || rnorm < eps_abs ) break;
 #endif
         if ( omega == 0 )
@@ -1163,8 +1186,7 @@ CGSolver::solve_cg (MultiFab&       sol,
         }
         sxay(sol, sol, alpha, p);
         sxay(  r,   r,-alpha, q);
-        rnorm = norm_inf(r);
-        sol_norm = norm_inf(sol);
+        norm_inf(r, rnorm, sol, sol_norm);
 
         if ( verbose > 2 && ParallelDescriptor::IOProcessor(color()) )
         {
@@ -82,6 +82,24 @@ Laplacian::Fsmooth (MultiFab&       solnL,
 {
     BL_PROFILE("Laplacian::Fsmooth()");
 
+    const bool tiling = true;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter solnLmfi(solnL,tiling); solnLmfi.isValid(); ++solnLmfi)
+    {
+        gsrb(solnLmfi, solnL, rhsL, level, redBlackFlag);
+    }
+}
+
+void
+Laplacian::gsrb (const MFIter&   solnLmfi,
+                 MultiFab&       solnL,
+                 const MultiFab& rhsL,
+                 int             level,
+                 int             redBlackFlag)
+{
     OrientationIter oitr;
 
     const FabSet& f0 = undrrelxr[level][oitr()]; oitr++;
@@ -105,6 +123,105 @@ Laplacian::Fsmooth (MultiFab&       solnL,
 
     const int nc = rhsL.nComp();
 
+    const Mask& m0 = mm0[solnLmfi];
+    const Mask& m1 = mm1[solnLmfi];
+    const Mask& m2 = mm2[solnLmfi];
+    const Mask& m3 = mm3[solnLmfi];
+#if (BL_SPACEDIM > 2)
+    const Mask& m4 = mm4[solnLmfi];
+    const Mask& m5 = mm5[solnLmfi];
+#endif
+
+    const Box&       tbx     = solnLmfi.tilebox();
+    const Box&       vbx     = solnLmfi.validbox();
+    FArrayBox&       solnfab = solnL[solnLmfi];
+    const FArrayBox& rhsfab  = rhsL[solnLmfi];
+    const FArrayBox& f0fab   = f0[solnLmfi];
+    const FArrayBox& f1fab   = f1[solnLmfi];
+    const FArrayBox& f2fab   = f2[solnLmfi];
+    const FArrayBox& f3fab   = f3[solnLmfi];
+#if (BL_SPACEDIM == 3)
+    const FArrayBox& f4fab   = f4[solnLmfi];
+    const FArrayBox& f5fab   = f5[solnLmfi];
+#endif
+
+#if (BL_SPACEDIM == 2)
+    FORT_GSRB(
+        solnfab.dataPtr(), 
+        ARLIM(solnfab.loVect()),ARLIM(solnfab.hiVect()),
+        rhsfab.dataPtr(), 
+        ARLIM(rhsfab.loVect()), ARLIM(rhsfab.hiVect()),
+        f0fab.dataPtr(), 
+        ARLIM(f0fab.loVect()), ARLIM(f0fab.hiVect()),
+        m0.dataPtr(), 
+        ARLIM(m0.loVect()), ARLIM(m0.hiVect()),
+        f1fab.dataPtr(), 
+        ARLIM(f1fab.loVect()), ARLIM(f1fab.hiVect()),
+        m1.dataPtr(), 
+        ARLIM(m1.loVect()), ARLIM(m1.hiVect()),
+        f2fab.dataPtr(), 
+        ARLIM(f2fab.loVect()), ARLIM(f2fab.hiVect()),
+        m2.dataPtr(), 
+        ARLIM(m2.loVect()), ARLIM(m2.hiVect()),
+        f3fab.dataPtr(), 
+        ARLIM(f3fab.loVect()), ARLIM(f3fab.hiVect()),
+        m3.dataPtr(), 
+        ARLIM(m3.loVect()), ARLIM(m3.hiVect()),
+        tbx.loVect(), tbx.hiVect(), vbx.loVect(), vbx.hiVect(),
+        &nc, h[level].data(), &redBlackFlag);
+#endif
+
+#if (BL_SPACEDIM == 3)
+    FORT_GSRB(
+        solnfab.dataPtr(), 
+        ARLIM(solnfab.loVect()),ARLIM(solnfab.hiVect()),
+        rhsfab.dataPtr(), 
+        ARLIM(rhsfab.loVect()), ARLIM(rhsfab.hiVect()),
+        f0fab.dataPtr(), 
+        ARLIM(f0fab.loVect()), ARLIM(f0fab.hiVect()),
+        m0.dataPtr(), 
+        ARLIM(m0.loVect()), ARLIM(m0.hiVect()),
+        f1fab.dataPtr(), 
+        ARLIM(f1fab.loVect()), ARLIM(f1fab.hiVect()),
+        m1.dataPtr(), 
+        ARLIM(m1.loVect()), ARLIM(m1.hiVect()),
+        f2fab.dataPtr(), 
+        ARLIM(f2fab.loVect()), ARLIM(f2fab.hiVect()),
+        m2.dataPtr(), 
+        ARLIM(m2.loVect()), ARLIM(m2.hiVect()),
+        f3fab.dataPtr(), 
+        ARLIM(f3fab.loVect()), ARLIM(f3fab.hiVect()),
+        m3.dataPtr(), 
+        ARLIM(m3.loVect()), ARLIM(m3.hiVect()),
+        f4fab.dataPtr(), 
+        ARLIM(f4fab.loVect()), ARLIM(f4fab.hiVect()),
+        m4.dataPtr(), 
+        ARLIM(m4.loVect()), ARLIM(m4.hiVect()),
+        f5fab.dataPtr(), 
+        ARLIM(f5fab.loVect()), ARLIM(f5fab.hiVect()),
+        m5.dataPtr(), 
+        ARLIM(m5.loVect()), ARLIM(m5.hiVect()),
+        tbx.loVect(), tbx.hiVect(), vbx.loVect(), vbx.hiVect(),
+        &nc, h[level].data(), &redBlackFlag);
+#endif
+}
+
+void
+Laplacian::Fsmooth_halo (MultiFab&         solnL,
+                         const MultiFab&   rhsL,
+                         int               level,
+                         int               redBlackFlag,
+                         int               ngrow,
+                         const Array<int>& halo_grids)
+{
+    BL_PROFILE("Laplacian::Fsmooth_halo()");
+
+    BL_ASSERT(solnL.nGrow() > ngrow);
+    BL_ASSERT(rhsL.nGrow() >= ngrow);
+
+#if (BL_SPACEDIM > 1)
+    const int nc = rhsL.nComp();
+
     const bool tiling = true;
 
 #ifdef _OPENMP
@@ -112,88 +229,25 @@ Laplacian::Fsmooth (MultiFab&       solnL,
 #endif
     for (MFIter solnLmfi(solnL,tiling); solnLmfi.isValid(); ++solnLmfi)
     {
-	const Mask& m0 = mm0[solnLmfi];
-        const Mask& m1 = mm1[solnLmfi];
-        const Mask& m2 = mm2[solnLmfi];
-        const Mask& m3 = mm3[solnLmfi];
-#if (BL_SPACEDIM > 2)
-        const Mask& m4 = mm4[solnLmfi];
-        const Mask& m5 = mm5[solnLmfi];
-#endif
+        if (!halo_grids[solnLmfi.index()])
+        {
+            gsrb(solnLmfi, solnL, rhsL, level, redBlackFlag);
+            continue;
+        }
 
-	const Box&       tbx     = solnLmfi.tilebox();
-        const Box&       vbx     = solnLmfi.validbox();
+        const Box&       tbx     = solnLmfi.growntilebox(ngrow);
         FArrayBox&       solnfab = solnL[solnLmfi];
         const FArrayBox& rhsfab  = rhsL[solnLmfi];
-        const FArrayBox& f0fab   = f0[solnLmfi];
-        const FArrayBox& f1fab   = f1[solnLmfi];
-        const FArrayBox& f2fab   = f2[solnLmfi];
-        const FArrayBox& f3fab   = f3[solnLmfi];
-#if (BL_SPACEDIM == 3)
-        const FArrayBox& f4fab   = f4[solnLmfi];
-        const FArrayBox& f5fab   = f5[solnLmfi];
-#endif
 
-#if (BL_SPACEDIM == 2)
-        FORT_GSRB(
+        FORT_GSRB_HALO(
             solnfab.dataPtr(), 
             ARLIM(solnfab.loVect()),ARLIM(solnfab.hiVect()),
             rhsfab.dataPtr(), 
             ARLIM(rhsfab.loVect()), ARLIM(rhsfab.hiVect()),
-            f0fab.dataPtr(), 
-            ARLIM(f0fab.loVect()), ARLIM(f0fab.hiVect()),
-            m0.dataPtr(), 
-            ARLIM(m0.loVect()), ARLIM(m0.hiVect()),
-            f1fab.dataPtr(), 
-            ARLIM(f1fab.loVect()), ARLIM(f1fab.hiVect()),
-            m1.dataPtr(), 
-            ARLIM(m1.loVect()), ARLIM(m1.hiVect()),
-            f2fab.dataPtr(), 
-            ARLIM(f2fab.loVect()), ARLIM(f2fab.hiVect()),
-            m2.dataPtr(), 
-            ARLIM(m2.loVect()), ARLIM(m2.hiVect()),
-            f3fab.dataPtr(), 
-            ARLIM(f3fab.loVect()), ARLIM(f3fab.hiVect()),
-            m3.dataPtr(), 
-            ARLIM(m3.loVect()), ARLIM(m3.hiVect()),
-	    tbx.loVect(), tbx.hiVect(), vbx.loVect(), vbx.hiVect(),
+            tbx.loVect(), tbx.hiVect(),
             &nc, h[level].data(), &redBlackFlag);
-#endif
-
-#if (BL_SPACEDIM == 3)
-        FORT_GSRB(
-            solnfab.dataPtr(), 
-            ARLIM(solnfab.loVect()),ARLIM(solnfab.hiVect()),
-            rhsfab.dataPtr(), 
-            ARLIM(rhsfab.loVect()), ARLIM(rhsfab.hiVect()),
-            f0fab.dataPtr(), 
-            ARLIM(f0fab.loVect()), ARLIM(f0fab.hiVect()),
-            m0.dataPtr(), 
-            ARLIM(m0.loVect()), ARLIM(m0.hiVect()),
-            f1fab.dataPtr(), 
-            ARLIM(f1fab.loVect()), ARLIM(f1fab.hiVect()),
-            m1.dataPtr(), 
-            ARLIM(m1.loVect()), ARLIM(m1.hiVect()),
-            f2fab.dataPtr(), 
-            ARLIM(f2fab.loVect()), ARLIM(f2fab.hiVect()),
-            m2.dataPtr(), 
-            ARLIM(m2.loVect()), ARLIM(m2.hiVect()),
-            f3fab.dataPtr(), 
-            ARLIM(f3fab.loVect()), ARLIM(f3fab.hiVect()),
-            m3.dataPtr(), 
-            ARLIM(m3.loVect()), ARLIM(m3.hiVect()),
-            f4fab.dataPtr(), 
-            ARLIM(f4fab.loVect()), ARLIM(f4fab.hiVect()),
-            m4.dataPtr(), 
-            ARLIM(m4.loVect()), ARLIM(m4.hiVect()),
-            f5fab.dataPtr(), 
-            ARLIM(f5fab.loVect()), ARLIM(f5fab.hiVect()),
-            m5.dataPtr(), 
-            ARLIM(m5.loVect()), ARLIM(m5.hiVect()),
-	    tbx.loVect(), tbx.hiVect(), vbx.loVect(), vbx.hiVect(),
-	    &nc, h[level].data(), &redBlackFlag);
-#endif
     }
+#endif
 }
 
 void
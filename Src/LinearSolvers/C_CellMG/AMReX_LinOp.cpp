@@ -1,5 +1,6 @@
 
 #include <cstdlib>
+#include <algorithm>
 
 #include <AMReX_ParmParse.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -12,6 +13,48 @@ namespace amrex {
 namespace
 {
     bool initialized = false;
+    //
+    // True if bx grown by ngrow lies inside the domain (allowing for
+    // periodicity) and is covered by the Boxes in ba, so no physical or
+    // coarse/fine boundary is within ngrow of it.  The red-black colors
+    // come from the cell indices, so a halo cell only has the color of
+    // its periodic image if the period is even; the halo must also not
+    // reach past one period.  In the other periodic directions the grown
+    // box must stay inside the domain.
+    //
+    bool
+    HaloIsInterior (const Box& bx, const BoxArray& ba, const Geometry& geom, int ngrow)
+    {
+        const Box& domain = geom.Domain();
+        const Box& gbx    = amrex::grow(bx, ngrow);
+
+        for (int d = 0; d < BL_SPACEDIM; ++d)
+        {
+            const bool wraps = geom.isPeriodic(d) &&
+                domain.length(d) % 2 == 0 && domain.length(d) >= ngrow;
+
+            if (!wraps &&
+                (gbx.smallEnd(d) < domain.smallEnd(d) || gbx.bigEnd(d) > domain.bigEnd(d)))
+                return false;
+        }
+
+        const Box& ibx = gbx & domain;
+        if (ibx.ok() && !ba.contains(ibx, true))
+            return false;
+
+        Array<IntVect> pshifts(27);
+
+        geom.periodicShift(domain, gbx, pshifts);
+
+        for (const auto& iv : pshifts)
+        {
+            const Box& sbx = (gbx + iv) & domain;
+            if (!ba.contains(sbx, true))
+                return false;
+        }
+
+        return true;
+    }
 }
 //
 // Set default values for these in Initialize()!!!
@@ -19,6 +62,7 @@ namespace
 int LinOp::def_harmavg;
 int LinOp::def_verbose;
 int LinOp::def_maxorder;
+int LinOp::def_smooth_halo;
 int LinOp::LinOp_grow;
 
 // Important:
@@ -37,6 +81,7 @@ LinOp::Initialize ()
     LinOp::def_harmavg  = 0;
     LinOp::def_verbose  = 0;
     LinOp::def_maxorder = 2;
+    LinOp::def_smooth_halo = 1;
     LinOp::LinOp_grow   = 1; // Must be consistent with expectations of apply/applyBC, not parm-parsed
 
     ParmParse pp("Lp");
@@ -44,11 +89,13 @@ LinOp::Initialize ()
     pp.query("harmavg",  def_harmavg);
     pp.query("v",        def_verbose);
     pp.query("maxorder", def_maxorder);
+    pp.query("smooth_halo", def_smooth_halo);
 
     if (ParallelDescriptor::IOProcessor() && def_verbose)
     {
         std::cout << "def_harmavg = "  << def_harmavg  << '\n';
         std::cout << "def_maxorder = " << def_maxorder << '\n';
+        std::cout << "def_smooth_halo = " << def_smooth_halo << '\n';
     }
 
     amrex::ExecOnFinalize(LinOp::Finalize);
@@ -131,6 +178,7 @@ LinOp::initConstruct (const Real* _h)
     geomarray[level] = bgb->getGeom();
     h.resize(1);
     maxorder = def_maxorder;
+    smooth_halo = def_smooth_halo;
 
     for (int i = 0; i < BL_SPACEDIM; i++)
     {
@@ -191,6 +239,24 @@ LinOp::applyBC (MultiFab&      inout,
     BL_ASSERT(level < numLevels());
     BL_ASSERT(!(level > 0 && bc_mode == Inhomogeneous_BC));
 
+    prepareForLevel(level);
+
+    const bool cross = true;
+    inout.FillBoundary(src_comp,num_comp,geomarray[level].periodicity(),cross);
+
+    applyBndryCond(inout,src_comp,num_comp,level,bc_mode,local,bndry_comp);
+}
+
+void
+LinOp::applyBndryCond (MultiFab&         inout,
+                       int               src_comp,
+                       int               num_comp,
+                       int               level,
+                       LinOp::BC_Mode    bc_mode,
+                       bool              local,
+                       int               bndry_comp,
+                       const Array<int>* skip)
+{
     int flagden = 1; // Fill in undrrelxr.
     int flagbc  = 1; // Fill boundary data.
 
@@ -199,12 +265,6 @@ LinOp::applyBC (MultiFab&      inout,
         // No data if homogeneous.
         //
         flagbc = 0;
-
-    prepareForLevel(level);
-
-    const bool cross = true;
-    inout.FillBoundary(src_comp,num_comp,geomarray[level].periodicity(),cross);
-
     //
     // Fill boundary cells.
     //
@@ -216,6 +276,9 @@ LinOp::applyBC (MultiFab&      inout,
     {
         const int gn = mfi.index();
 
+        if (skip && (*skip)[gn])
+            continue;
+
         BL_ASSERT(gbox[level][gn] == inout.box(gn));
         BL_ASSERT(level<undrrelxr.size());
 
@@ -294,6 +357,166 @@ LinOp::jacobi_smooth (MultiFab&       solnL,
     Fsmooth_jacobi(solnL, rhsL, level);
 }
 
+void
+LinOp::multi_smooth (MultiFab&      solnL,
+                     MultiFab&      rhsL,
+                     int            level,
+                     LinOp::BC_Mode bc_mode,
+                     int            nsweep)
+{
+    BL_PROFILE("LinOp::multi_smooth()");
+
+    if (nsweep <= 0) return;
+
+    const int nhalo = std::min(NumSmoothGrow(level),
+                               std::min(solnL.nGrow(), rhsL.nGrow()+1));
+
+    if (nhalo <= LinOp_grow)
+    {
+        for (int i = 0; i < nsweep; ++i)
+            smooth(solnL, rhsL, level, bc_mode);
+        return;
+    }
+    //
+    // The halo grids lie in the interior of the level, so no physical or
+    // coarse/fine boundary values are needed there.  Each half sweep
+    // leaves the outermost layer of their halo stale, hence nhalo half
+    // sweeps per exchange.  The other grids are swept as in smooth(),
+    // with their first layer of ghost cells refilled from the neighbors
+    // through halo_edge before each half sweep but the first of a block.
+    // rhsL is not changed by the sweeps and is exchanged once.
+    //
+    const Periodicity& period = geomarray[level].periodicity();
+    const Array<int>&  grids  = halo_grids[level];
+
+    if (halo_edge.size() <= level)
+        halo_edge.resize(level+1);
+
+    if (!halo_edge[level] && std::find(grids.begin(), grids.end(), 0) != grids.end())
+    {
+        BoxList      bl;
+        Array<int>   pmap;
+        const DistributionMapping& dm = solnL.DistributionMap();
+
+        for (int i = 0, N = grids.size(); i < N; ++i)
+        {
+            if (!grids[i])
+            {
+                bl.push_back(gbox[level][i]);
+                pmap.push_back(dm[i]);
+            }
+        }
+
+        halo_edge[level].reset(new MultiFab(BoxArray(bl),
+                                            DistributionMapping(pmap,dm.color()),
+                                            1, 1));
+    }
+
+    MultiFab* edge = halo_edge[level].get();
+
+    rhsL.FillBoundary_nowait(period);
+    bool rhs_filled = false;
+
+    int redBlackFlag = 0;
+
+    for (int nhalf = 2*nsweep; nhalf > 0; )
+    {
+        const int nh = std::min(nhalf, nhalo);
+
+        solnL.FillBoundary_nowait(period);
+        if (!rhs_filled)
+        {
+            rhsL.FillBoundary_finish();
+            rhs_filled = true;
+        }
+        solnL.FillBoundary_finish();
+
+        for (int ngrow = nh-1; ngrow >= 0; --ngrow)
+        {
+            if (edge)
+            {
+                if (ngrow < nh-1)
+                    fillHaloEdge(solnL, *edge, level);
+                applyBndryCond(solnL, 0, 1, level, bc_mode, false, 0, &grids);
+            }
+            Fsmooth_halo(solnL, rhsL, level, redBlackFlag, ngrow, grids);
+            redBlackFlag = 1 - redBlackFlag;
+        }
+
+        nhalf -= nh;
+    }
+}
+
+void
+LinOp::fillHaloEdge (MultiFab& solnL,
+                     MultiFab& edge,
+                     int       level)
+{
+    BL_PROFILE("LinOp::fillHaloEdge()");
+    //
+    // edge lives on the grids without a halo, on the same processors as
+    // solnL.  The ghost cells not covered by the level keep the values of
+    // solnL, to be overwritten by applyBndryCond.
+    //
+    const Array<int>& grids = halo_grids[level];
+
+    Array<int> index;
+    for (int i = 0, N = grids.size(); i < N; ++i)
+        if (!grids[i])
+            index.push_back(i);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(edge); mfi.isValid(); ++mfi)
+        edge[mfi].copy(solnL[index[mfi.index()]], mfi.fabbox());
+
+    edge.ParallelCopy(solnL, 0, 0, 1, 0, 1, geomarray[level].periodicity());
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    for (MFIter mfi(edge); mfi.isValid(); ++mfi)
+        solnL[index[mfi.index()]].copy(edge[mfi], mfi.fabbox());
+}
+
+int
+LinOp::NumSmoothGrow (int level)
+{
+    if (smooth_halo <= NumGrow(level) || !haloSmoothable())
+        return NumGrow(level);
+
+    prepareForLevel(level);
+
+    if (halo_grids.size() <= level)
+        halo_grids.resize(level+1);
+
+    Array<int>& grids = halo_grids[level];
+
+    if (grids.empty())
+    {
+        const BoxArray& ba = gbox[level];
+
+        grids.resize(ba.size());
+
+        for (int i = 0, N = ba.size(); i < N; ++i)
+            grids[i] = HaloIsInterior(ba[i], ba, geomarray[level], smooth_halo);
+    }
+
+    return std::find(grids.begin(), grids.end(), 1) != grids.end() ? smooth_halo : NumGrow(level);
+}
+
+void
+LinOp::Fsmooth_halo (MultiFab&         /*solnL*/,
+                     const MultiFab&   /*rhsL*/,
+                     int               /*level*/,
+                     int               /*rgbflag*/,
+                     int               /*ngrow*/,
+                     const Array<int>& /*halo_grids*/)
+{
+    amrex::Error("LinOp::Fsmooth_halo: Placeholder for virtual function");
+}
+
 Real
 LinOp::norm (int nm, int level, const bool local)
 {
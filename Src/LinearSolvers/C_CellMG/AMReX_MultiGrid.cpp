@@ -235,9 +235,13 @@ MultiGrid::prepareForLevel (int level)
     if ( cor[level] == 0 )
     {
 	const DistributionMapping& dm = Lp.DistributionMap();
+        //
+        // cor and rhs carry the deeper halo used by LinOp::multi_smooth.
+        //
+        const int ngs = std::max(Lp.NumGrow(), Lp.NumSmoothGrow(level));
 	res[level] = new MultiFab(Lp.boxArray(level), dm, 1, Lp.NumGrow(), MFInfo(), FArrayBoxFactory());
-	rhs[level] = new MultiFab(Lp.boxArray(level), dm, 1, Lp.NumGrow(), MFInfo(), FArrayBoxFactory());
-	cor[level] = new MultiFab(Lp.boxArray(level), dm, 1, Lp.NumGrow(), MFInfo(), FArrayBoxFactory());
+	rhs[level] = new MultiFab(Lp.boxArray(level), dm, 1, ngs, MFInfo(), FArrayBoxFactory());
+	cor[level] = new MultiFab(Lp.boxArray(level), dm, 1, ngs, MFInfo(), FArrayBoxFactory());
 	if ( level == 0 )
 	{
 	    initialsolution = new MultiFab(Lp.boxArray(0), dm, 1, Lp.NumGrow(), MFInfo(), FArrayBoxFactory());
@@ -597,10 +601,7 @@ MultiGrid::relax (MultiFab&      solL,
               std::cout << "    DN:Norm before smooth " << rnorm << '\n';;
            }
         }
-        for (int i = preSmooth() ; i > 0 ; i--)
-        {
-            Lp.smooth(solL, rhsL, level, bc_mode);
-        }
+        Lp.multi_smooth(solL, rhsL, level, bc_mode, preSmooth());
         Lp.residual(*res[level], rhsL, solL, level, bc_mode);
 
         if ( verbose > 2 )
@@ -630,10 +631,7 @@ MultiGrid::relax (MultiFab&      solL,
            }
         }
 
-        for (int i = postSmooth(); i > 0 ; i--)
-        {
-            Lp.smooth(solL, rhsL, level, bc_mode);
-        }
+        Lp.multi_smooth(solL, rhsL, level, bc_mode, postSmooth());
         if ( verbose > 2 )
         {
            Lp.residual(*res[level], rhsL, solL, level, bc_mode);
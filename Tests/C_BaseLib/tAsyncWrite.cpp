@@ -0,0 +1,97 @@
+#include <iostream>
+#include <cmath>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Write MultiFabs with VisMF::AsyncWrite for each header version, FAB
+// format and a few numbers of files, then read them back with VisMF::Read.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba, dm, 2, 1);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.fabbox();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                mf[mfi](iv,0) = std::sin(0.1*D_TERM(iv[0], + 2*iv[1], + 3*iv[2]));
+                mf[mfi](iv,1) = 1.0 + iv[0];
+            }
+        }
+
+        const std::string dir("tAsyncWrite.dir");
+        amrex::UtilCreateCleanDirectory(dir, true);
+
+        const VisMF::Header::Version versions[] = { VisMF::Header::Version_v1,
+                                                    VisMF::Header::NoFabHeader_v1,
+                                                    VisMF::Header::NoFabHeaderMinMax_v1 };
+        const FABio::Format formats[] = { FABio::FAB_NATIVE, FABio::FAB_IEEE_32 };
+        const int nfiles[] = { 1, 2, ParallelDescriptor::NProcs() };
+
+        Real maxdiff = 0.0;
+        int ntest = 0;
+
+        for (auto version : versions) {
+            for (auto format : formats) {
+                for (auto nf : nfiles) {
+                    VisMF::SetHeaderVersion(version);
+                    FArrayBox::setFormat(format);
+                    VisMF::SetNOutFiles(nf);
+
+                    const std::string name = amrex::Concatenate(dir + "/mf", ntest++, 2);
+
+                    VisMF::AsyncWrite(mf, name);
+
+                    MultiFab mf2(ba, dm, 2, 1);
+                    VisMF::Read(mf2, name);
+
+                    const Real tol = (format == FABio::FAB_NATIVE) ? 0.0 : 1.e-6;
+                    for (MFIter mfi(mf2); mfi.isValid(); ++mfi) {
+                        const int i = mfi.index();
+                        FArrayBox fab(mf2[mfi].box(), mf2.nComp());
+                        fab.copy(mf2[mfi]);
+                        fab.minus(mf[i]);
+                        Real d = fab.norm(0, 0, mf2.nComp()) / (1.0 + ncell);
+                        if (d > tol) maxdiff = std::max(maxdiff, d);
+                    }
+                }
+            }
+        }
+
+        ParallelDescriptor::ReduceRealMax(maxdiff);
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << ntest << " MultiFabs written, max difference beyond tolerance: "
+                      << maxdiff << std::endl;
+
+        if (maxdiff > 0.0)
+            amrex::Abort("VisMF::AsyncWrite failed");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <fstream>
+#include <AMReX_BoxArray.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Compare the SFC and SFCCOMM distributions, and the KNAPSACK and
+// KNAPSACKNODE distributions: number of cell faces cut by the partition
+// (between processes, and between nodes of node_size processes) and load
+// balance efficiency.
+//
+static
+void
+Report (const BoxArray& ba, const DistributionMapping& dm, int nprocs, const char* name,
+        int node_size = 1)
+{
+    long cut = 0, node_cut = 0;
+    for (int i = 0; i < ba.size(); ++i)
+    {
+        for (int idim = 0; idim < BL_SPACEDIM; ++idim)
+        {
+            for (auto const& is : ba.intersections(amrex::grow(ba[i],idim,1))) {
+                if (is.first != i && dm[is.first] != dm[i]) cut += is.second.numPts();
+                if (is.first != i && dm[is.first]/node_size != dm[i]/node_size)
+                    node_cut += is.second.numPts();
+            }
+        }
+    }
+
+    Array<long> load(nprocs, 0);
+    long total = 0;
+    for (int i = 0; i < ba.size(); ++i) {
+        load[dm[i]] += ba[i].numPts();
+        total += ba[i].numPts();
+    }
+    const long max_load = *std::max_element(load.begin(), load.end());
+
+    std::cout << name << ": cut faces = " << cut/2;
+    if (node_size > 1) std::cout << ", between nodes = " << node_cut/2;
+    std::cout << ", efficiency = " << double(total)/(nprocs*double(max_load)) << '\n';
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        std::string ba_file("ba.3865");
+        {
+            ParmParse pp;
+            pp.query("ba_file", ba_file);
+        }
+        // Must match DistributionMapping.node_size, e.g., run with
+        // DistributionMapping.node_size=4 on a single node.
+        int node_size = 1;
+        {
+            ParmParse pp("DistributionMapping");
+            pp.query("node_size", node_size);
+        }
+
+        std::ifstream ifs(ba_file.c_str(), std::ios::in);
+
+        BoxArray ba;
+        ba.readFrom(ifs);
+
+        const int nprocs = ParallelDescriptor::NProcs();
+
+        DistributionMapping::strategy(DistributionMapping::SFC);
+        DistributionMapping dm1(ba,nprocs);
+
+        DistributionMapping::strategy(DistributionMapping::SFCCOMM);
+        DistributionMapping dm2(ba,nprocs);
+
+        DistributionMapping::strategy(DistributionMapping::KNAPSACK);
+        DistributionMapping dm3(ba,nprocs);
+
+        DistributionMapping::strategy(DistributionMapping::KNAPSACKNODE);
+        DistributionMapping dm4(ba,nprocs);
+
+        if (ParallelDescriptor::IOProcessor())
+        {
+            std::cout << "# of grids: " << ba.size() << ", nprocs = " << nprocs << '\n';
+            Report(ba, dm1, nprocs, "SFC    ");
+            Report(ba, dm2, nprocs, "SFCCOMM");
+            Report(ba, dm3, nprocs, "KNAPSACK    ", node_size);
+            Report(ba, dm4, nprocs, "KNAPSACKNODE", node_size);
+        }
+    }
+    amrex::Finalize();
+}
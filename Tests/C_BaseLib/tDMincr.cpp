@@ -0,0 +1,75 @@
+#include <iostream>
+#include <AMReX_BoxArray.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Regrid-like test: compare how many cells must move to new owners when the
+// mapping of a shifted BoxArray is computed from scratch and incrementally
+// from the old BoxArray and DistributionMapping.
+//
+static
+void
+Report (const BoxArray& ba, const DistributionMapping& dm,
+        const BoxArray& old_ba, const DistributionMapping& old_dm, const char* name)
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    long moved = 0, total = 0;
+    Array<long> load(nprocs, 0);
+    for (int i = 0; i < ba.size(); ++i)
+    {
+        for (auto const& is : old_ba.intersections(ba[i])) {
+            if (old_dm[is.first] != dm[i]) moved += is.second.numPts();
+        }
+        load[dm[i]] += ba[i].numPts();
+        total += ba[i].numPts();
+    }
+    const long max_load = *std::max_element(load.begin(), load.end());
+
+    std::cout << name << ": cells moved = " << moved
+              << ", efficiency = " << double(total)/(nprocs*double(max_load)) << '\n';
+}
+
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 128;
+        int max_grid_size = 16;
+        int shift = 4;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("shift", shift);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray old_ba(amrex::grow(domain,-ncell/4));
+        old_ba.maxSize(max_grid_size);
+        DistributionMapping old_dm(old_ba);
+
+        // The refined region moves and grows a bit.
+        Box bx = amrex::grow(domain,-ncell/4);
+        bx.shift(0,shift);
+        bx.growHi(1,max_grid_size);
+        BoxArray ba(bx);
+        ba.maxSize(max_grid_size);
+
+        DistributionMapping dm1(ba);
+        DistributionMapping dm2 = DistributionMapping::makeIncremental(ba, old_ba, old_dm);
+
+        if (ParallelDescriptor::IOProcessor())
+        {
+            Report(ba, dm1, old_ba, old_dm, "from scratch");
+            Report(ba, dm2, old_ba, old_dm, "incremental ");
+        }
+    }
+    amrex::Finalize();
+}
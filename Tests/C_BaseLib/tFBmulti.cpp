@@ -0,0 +1,94 @@
+#include <iostream>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Compare the fused FillBoundary on several MultiFabs against calling
+// FillBoundary on each of them.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 16;
+        int nmf = 3;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("nmf", nmf);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        Periodicity period(IntVect(D_DECL(ncell,ncell,ncell)));
+
+        const int ng = 2;
+
+        Array<std::unique_ptr<MultiFab> > mf1(nmf), mf2(nmf);
+        Array<MultiFab*> pmf(nmf);
+        Array<int> scomp(nmf), ncomp(nmf);
+
+        for (int i = 0; i < nmf; ++i)
+        {
+            const int nc = i+1;
+            mf1[i].reset(new MultiFab(ba, dm, nc, ng));
+            mf2[i].reset(new MultiFab(ba, dm, nc, ng));
+            pmf[i] = mf2[i].get();
+            scomp[i] = (nc > 1) ? 1 : 0;
+            ncomp[i] = nc - scomp[i];
+
+            for (MFIter mfi(*mf1[i]); mfi.isValid(); ++mfi)
+            {
+                FArrayBox& fab = (*mf1[i])[mfi];
+                fab.setVal(-1.0);
+                const Box& bx = mfi.validbox();
+                for (int n = 0; n < nc; ++n) {
+                    for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                        fab(iv,n) = D_TERM(iv[0], + 1.e2*iv[1], + 1.e4*iv[2]) + 1.e6*n + 1.e7*i;
+                    }
+                }
+            }
+            MultiFab::Copy(*mf2[i], *mf1[i], 0, 0, nc, ng);
+        }
+
+        Real maxdiff = 0.0;
+
+        for (int cross = 0; cross < 2; ++cross)
+        {
+            for (int i = 0; i < nmf; ++i) {
+                mf1[i]->FillBoundary(scomp[i], ncomp[i], period, cross);
+            }
+
+            amrex::FillBoundary(pmf, scomp, ncomp, period, cross);
+
+            for (int i = 0; i < nmf; ++i)
+            {
+                MultiFab diff(ba, dm, mf1[i]->nComp(), ng);
+                MultiFab::Copy(diff, *mf2[i], 0, 0, diff.nComp(), ng);
+                MultiFab::Subtract(diff, *mf1[i], 0, 0, diff.nComp(), ng);
+                for (int n = 0; n < diff.nComp(); ++n)
+                    maxdiff = std::max(maxdiff, diff.norm0(n, ng));
+            }
+        }
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << "max difference between fused and separate FillBoundary: "
+                      << maxdiff << std::endl;
+
+        if (maxdiff != 0.0)
+            amrex::Abort("fused FillBoundary failed");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
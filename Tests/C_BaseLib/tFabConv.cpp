@@ -0,0 +1,133 @@
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <AMReX_FabConv.H>
+#include <AMReX_FPC.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+namespace
+{
+    //
+    // The bytes of a float or double in the byte order of rd.
+    //
+    template <typename T>
+    void
+    toBytes (T v, const int* order, char* out)
+    {
+        unsigned char be[sizeof(T)];
+        uint64_t u = 0;
+        std::memcpy(&u, &v, sizeof(T));
+        for (int i = 0; i < int(sizeof(T)); ++i)
+            be[i] = (u >> (8*(sizeof(T) - 1 - i))) & 0xff;
+        for (int i = 0; i < int(sizeof(T)); ++i)
+            out[i] = be[order[i] - 1];
+    }
+
+    float
+    flushed (float f)
+    {
+        return (std::fpclassify(f) == FP_SUBNORMAL) ? 0.0f : f;
+    }
+}
+
+//
+// Convert between native Reals and IEEE 32 and 64 bit data in both byte
+// orders with RealDescriptor, checking the bytes against a reference.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        long nitems = 1 << 20;
+        {
+            ParmParse pp;
+            pp.query("nitems", nitems);
+        }
+
+        std::vector<Real> data(nitems);
+        for (long i = 0; i < nitems; ++i)
+            data[i] = (amrex::Random() - 0.5) * std::pow(10.0, int(80*amrex::Random()) - 40);
+        data[0] = 0.0;
+        data[1] = -1.e-40;  // ---- a float denormal
+        data[2] = std::numeric_limits<Real>::infinity();
+        data[3] = 1.e300;
+
+        const int* float_orders[]  = { FPC::normal_float_order,  FPC::reverse_float_order };
+        const int* double_orders[] = { FPC::normal_double_order, FPC::reverse_double_order };
+
+        int nfail = 0;
+
+        for (int width = 4; width <= 8; width += 4)
+        {
+            for (int o = 0; o < 2; ++o)
+            {
+                const int* order = (width == 4) ? float_orders[o] : double_orders[o];
+                RealDescriptor rd((width == 4) ? FPC::ieee_float : FPC::ieee_double, order, width);
+
+                std::vector<char> bytes(nitems*width), ref(nitems*width);
+                std::vector<Real> back(nitems);
+
+                Real t0 = ParallelDescriptor::second();
+                RealDescriptor::convertFromNativeFormat(bytes.data(), nitems, data.data(), rd);
+                Real t1 = ParallelDescriptor::second();
+
+                //
+                // Native to native 32 keeps the float denormals.
+                //
+                const bool keep = (rd == FPC::Native32RealDescriptor());
+
+                for (long i = 0; i < nitems; ++i) {
+                    if (width == 4) {
+                        const float f(data[i]);
+                        toBytes(keep ? f : flushed(f), order, &ref[i*width]);
+                    } else {
+                        toBytes(double(data[i]), order, &ref[i*width]);
+                    }
+                }
+                if (bytes != ref) {
+                    std::cout << "FAIL: to IEEE " << 8*width << " order " << o << std::endl;
+                    ++nfail;
+                }
+
+                std::istringstream is(std::string(bytes.begin(), bytes.end()));
+                Real t2 = ParallelDescriptor::second();
+                RealDescriptor::convertToNativeFormat(back.data(), nitems, is, rd);
+                Real t3 = ParallelDescriptor::second();
+
+                for (long i = 0; i < nitems; ++i) {
+                    const Real expect = (width == 4) ? Real(flushed(float(data[i]))) : data[i];
+                    if (std::isnan(expect) && std::isnan(back[i]))
+                        continue;
+                    if (std::memcmp(&back[i], &expect, sizeof(Real)) != 0) {
+                        std::cout << "FAIL: from IEEE " << 8*width << " order " << o
+                                  << " item " << i << std::endl;
+                        ++nfail;
+                        break;
+                    }
+                }
+
+                if (ParallelDescriptor::IOProcessor())
+                    std::cout << "IEEE " << 8*width << (o == 0 ? " normal " : " reverse")
+                              << " order:  to " << (t1 - t0) << "s  from " << (t3 - t2) << "s"
+                              << std::endl;
+            }
+        }
+
+        if (nfail > 0)
+            amrex::Abort("RealDescriptor conversion failed");
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << "RealDescriptor conversions passed" << std::endl;
+    }
+    amrex::Finalize();
+
+    return 0;
+}
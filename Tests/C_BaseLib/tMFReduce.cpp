@@ -0,0 +1,91 @@
+#include <iostream>
+#include <cmath>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_MFReduce.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Compare the fused reductions of MFReduce against the MultiFab member
+// functions, with two MultiFabs on one BoxArray and a third on another.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+
+        BoxArray ba2(domain);
+        ba2.maxSize(max_grid_size/2);
+
+        DistributionMapping dm(ba);
+        DistributionMapping dm2(ba2);
+
+        const int ng = 1;
+
+        MultiFab x(ba, dm, 2, ng);
+        MultiFab y(ba, dm, 1, ng);
+        MultiFab z(ba2, dm2, 1, 0);
+
+        for (MFIter mfi(x); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.fabbox();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                x[mfi](iv,0) = std::sin(0.1*D_TERM(iv[0], + 2*iv[1], + 3*iv[2]));
+                x[mfi](iv,1) = 1.0 + iv[0];
+                y[mfi](iv,0) = std::cos(0.2*D_TERM(iv[0], - iv[1], + iv[2]));
+            }
+        }
+        for (MFIter mfi(z); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.fabbox();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+                z[mfi](iv,0) = 0.5 - iv[1];
+        }
+
+        MFReduce red;
+        Array<int>  idx;
+        Array<Real> ref;
+
+        idx.push_back(red.addNorm0(x, 0, ng));   ref.push_back(x.norm0(0, ng));
+        idx.push_back(red.addNorm1(x, 1));       ref.push_back(x.norm1(1));
+        idx.push_back(red.addNorm2(y));          ref.push_back(y.norm2(0));
+        idx.push_back(red.addSum(x, 1));         ref.push_back(x.sum(1));
+        idx.push_back(red.addMin(y, 0, ng));     ref.push_back(y.min(0, ng));
+        idx.push_back(red.addMax(z));            ref.push_back(z.max(0));
+        idx.push_back(red.addMin(z));            ref.push_back(z.min(0));
+        idx.push_back(red.addDot(x, 0, y, 0, 1, ng));
+        ref.push_back(MultiFab::Dot(x, 0, y, 0, 1, ng));
+
+        red.eval();
+
+        Real maxdiff = 0.0;
+        for (int i = 0; i < idx.size(); ++i)
+            maxdiff = std::max(maxdiff, std::abs(red[idx[i]] - ref[i]) / std::max(1.0, std::abs(ref[i])));
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << "max relative difference between MFReduce and MultiFab: "
+                      << maxdiff << std::endl;
+
+        if (maxdiff > 1.e-12)
+            amrex::Abort("MFReduce failed");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <cmath>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Check the periodic norm1, norm2 and sum of nodal data, which use the
+// cached overlap mask, against dividing a copy by MultiFab::OverlapMask.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        ba.surroundingNodes();
+
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba, dm, 2, 0);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.fabbox();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                mf[mfi](iv,0) = 1.0;
+                mf[mfi](iv,1) = std::sin(0.1*D_TERM(iv[0], + 2*iv[1], + 3*iv[2]));
+            }
+        }
+
+        Real maxdiff = 0.0;
+
+        for (int iper = 0; iper < 2; ++iper)
+        {
+            const Periodicity period = (iper == 0) ? Periodicity::NonPeriodic()
+                : Periodicity(IntVect(D_DECL(ncell,ncell,ncell)));
+
+            auto mask = mf.OverlapMask(period);
+
+            for (int comp = 0; comp < 2; ++comp)
+            {
+                MultiFab tmp(ba, dm, 1, 0);
+                MultiFab::Copy(tmp, mf, comp, 0, 1, 0);
+                MultiFab::Divide(tmp, *mask, 0, 0, 1, 0);
+
+                Real ref_sum = 0.0, ref_nm1 = 0.0, ref_nm2 = 0.0;
+                for (MFIter mfi(tmp); mfi.isValid(); ++mfi)
+                {
+                    const Box& bx = mfi.validbox();
+                    ref_sum += tmp[mfi].sum(bx, 0, 1);
+                    ref_nm1 += tmp[mfi].norm(bx, 1, 0, 1);
+                    ref_nm2 += tmp[mfi].dot(bx, 0, mf[mfi], bx, comp, 1);
+                }
+                ParallelDescriptor::ReduceRealSum(ref_sum);
+                ParallelDescriptor::ReduceRealSum(ref_nm1);
+                ParallelDescriptor::ReduceRealSum(ref_nm2);
+                ref_nm2 = std::sqrt(ref_nm2);
+
+                // The same norms twice, the second time from the cache.
+                for (int k = 0; k < 2; ++k)
+                {
+                    maxdiff = std::max(maxdiff, std::abs(mf.sum  (comp, period) - ref_sum) / std::max(1.0, std::abs(ref_sum)));
+                    maxdiff = std::max(maxdiff, std::abs(mf.norm1(comp, period) - ref_nm1) / std::max(1.0, ref_nm1));
+                    maxdiff = std::max(maxdiff, std::abs(mf.norm2(comp, period) - ref_nm2) / std::max(1.0, ref_nm2));
+                }
+
+                const Real sm = mf.sum(comp, period);
+                if (comp == 0 && iper == 1 && ParallelDescriptor::IOProcessor())
+                    std::cout << "periodic sum of ones: " << sm
+                              << " (" << domain.numPts() << " cells)" << std::endl;
+            }
+        }
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << "max relative difference: " << maxdiff << std::endl;
+
+        if (maxdiff > 1.e-12)
+            amrex::Abort("periodic reductions failed");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Compare ParallelCopy_nowait/ParallelCopy_finish against ParallelCopy
+// for a copy between two different BoxArrays, with and without ghost
+// cells, periodicity and ADD.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 16;
+        int ncomp = 3;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ncomp", ncomp);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray sba(domain);
+        sba.maxSize(max_grid_size);
+
+        BoxArray dba(domain);
+        dba.maxSize(max_grid_size/2+3);
+
+        DistributionMapping sdm(sba);
+        DistributionMapping ddm(dba);
+
+        const int ng = 2;
+
+        MultiFab src(sba, sdm, ncomp, ng);
+        for (MFIter mfi(src); mfi.isValid(); ++mfi)
+        {
+            FArrayBox& fab = src[mfi];
+            const Box& bx = mfi.fabbox();
+            for (int n = 0; n < ncomp; ++n) {
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                    fab(iv,n) = D_TERM(iv[0], + 1.e2*iv[1], + 1.e4*iv[2]) + 1.e6*n;
+                }
+            }
+        }
+
+        Periodicity period(IntVect(D_DECL(ncell,ncell,ncell)));
+
+        MultiFab d1(dba, ddm, ncomp, ng);
+        MultiFab d2(dba, ddm, ncomp, ng);
+
+        Real maxdiff = 0.0;
+
+        for (int itest = 0; itest < 4; ++itest)
+        {
+            const int snghost = (itest >= 2) ? 1 : 0;
+            const int dnghost = (itest >= 2) ? ng : 0;
+            const FabArrayBase::CpOp op = (itest%2 == 0) ? FabArrayBase::COPY : FabArrayBase::ADD;
+
+            d1.setVal(1.0);
+            d2.setVal(1.0);
+
+            d1.ParallelCopy(src, 1, 0, ncomp-1, snghost, dnghost, period, op);
+
+            d2.ParallelCopy_nowait(src, 1, 0, ncomp-1, snghost, dnghost, period, op);
+            d2.ParallelCopy_finish();
+
+            MultiFab::Subtract(d2, d1, 0, 0, ncomp, ng);
+            for (int n = 0; n < ncomp; ++n)
+                maxdiff = std::max(maxdiff, d2.norm0(n, ng));
+        }
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << "max difference between ParallelCopy and ParallelCopy_nowait: "
+                      << maxdiff << std::endl;
+
+        if (maxdiff != 0.0)
+            amrex::Abort("ParallelCopy_nowait failed");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include <iostream>
+#include <fstream>
+#include <cmath>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+namespace
+{
+    //
+    // The number of bytes in the data files of the FabArray name.
+    //
+    long
+    dataBytes (const std::string& name)
+    {
+        long nbytes = 0;
+        for (int i = 0; ; ++i)
+        {
+            std::ifstream ifs(amrex::Concatenate(name + "_D_", i, 5).c_str(),
+                              std::ios::in | std::ios::binary | std::ios::ate);
+            if ( ! ifs.good())
+                break;
+            nbytes += ifs.tellg();
+        }
+        return nbytes;
+    }
+
+    Real
+    maxDiff (const MultiFab& a, const MultiFab& b)
+    {
+        Real diff = 0.0;
+        for (MFIter mfi(a); mfi.isValid(); ++mfi)
+        {
+            FArrayBox d(a[mfi].box(), a.nComp());
+            d.copy(a[mfi]);
+            d.minus(b[mfi]);
+            diff = std::max(diff, d.norm(0, 0, a.nComp()));
+        }
+        ParallelDescriptor::ReduceRealMax(diff);
+        return diff;
+    }
+}
+
+//
+// Write MultiFabs with FAB checksums in several header versions and
+// formats, with Write and AsyncWrite, and verify them.  Write them again
+// into a second directory with half the fabs changed, skipping the fabs
+// the first directory has, and check the data are smaller and read back
+// the same.  Then damage a data file of the first directory and check
+// both writes fail verification.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba, dm, 2, 1);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.fabbox();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                mf[mfi](iv,0) = std::sin(0.1*D_TERM(iv[0], + 2*iv[1], + 3*iv[2]));
+                mf[mfi](iv,1) = 1.0 + iv[0];
+            }
+        }
+
+        MultiFab mf2(ba, dm, 2, 1);
+        MultiFab::Copy(mf2, mf, 0, 0, 2, 1);
+        for (MFIter mfi(mf2); mfi.isValid(); ++mfi)
+            if (mfi.index() % 2 == 1)
+                mf2[mfi].plus(1.0);
+
+        const std::string dirA("tVisMFChecksum.A"), dirB("tVisMFChecksum.B");
+
+        const VisMF::Header::Version versions[] = { VisMF::Header::Version_v1,
+                                                    VisMF::Header::NoFabHeader_v1,
+                                                    VisMF::Header::Compressed_v1 };
+        const FABio::Format formats[] = { FABio::FAB_NATIVE, FABio::FAB_IEEE_32 };
+
+        VisMF::SetChecksums(true);
+        VisMF::SetNOutFiles(2);
+
+        int nfail = 0, ntest = 0;
+
+        for (auto version : versions) {
+            for (auto format : formats) {
+                for (int async = 0; async < 2; ++async) {
+                    VisMF::SetHeaderVersion(version);
+                    FArrayBox::setFormat(format);
+
+                    amrex::UtilCreateCleanDirectory(dirA, true);
+                    amrex::UtilCreateCleanDirectory(dirB, true);
+
+                    const std::string nameA(dirA + "/mf"), nameB(dirB + "/mf");
+
+                    VisMF::SetDedupDirectories("", "");
+                    if (async) {
+                        VisMF::AsyncWrite(mf, nameA);
+                        VisMF::AsyncWriteFence();
+                    } else {
+                        VisMF::Write(mf, nameA);
+                    }
+
+                    VisMF::SetDedupDirectories(dirA, dirB);
+                    if (async) {
+                        VisMF::AsyncWrite(mf2, nameB);
+                        VisMF::AsyncWriteFence();
+                    } else {
+                        VisMF::Write(mf2, nameB);
+                    }
+                    VisMF::SetDedupDirectories("", "");
+
+                    ParallelDescriptor::Barrier();
+
+                    if (VisMF::VerifyChecksums(nameA) != 0 || VisMF::VerifyChecksums(nameB) != 0) {
+                        amrex::Print() << "FAIL: verify, test " << ntest << std::endl;
+                        ++nfail;
+                    }
+
+                    long bytesA = 0, bytesB = 0;
+                    if (ParallelDescriptor::IOProcessor()) {
+                        bytesA = dataBytes(nameA);
+                        bytesB = dataBytes(nameB);
+                    }
+                    ParallelDescriptor::Bcast(&bytesA, 1);
+                    ParallelDescriptor::Bcast(&bytesB, 1);
+                    if ( ! (bytesB < 0.75 * bytesA)) {
+                        amrex::Print() << "FAIL: dedup, test " << ntest << ":  "
+                                       << bytesB << " of " << bytesA << " bytes" << std::endl;
+                        ++nfail;
+                    }
+
+                    MultiFab back(ba, dm, 2, 1);
+                    VisMF::Read(back, nameB);
+                    const Real tol = (format == FABio::FAB_IEEE_32) ? 1.e-6 : 0.0;
+                    if (maxDiff(back, mf2) > tol) {
+                        amrex::Print() << "FAIL: read back, test " << ntest << std::endl;
+                        ++nfail;
+                    }
+
+                    //
+                    // Damage a byte in the data of fab 0, which both use.
+                    //
+                    ParallelDescriptor::Barrier();
+                    if (ParallelDescriptor::IOProcessor()) {
+                        std::ifstream hdr((nameA + "_H").c_str());
+                        std::string token, file;
+                        long head = 0;
+                        while (hdr >> token && token != "FabOnDisk:")
+                            ;
+                        hdr >> file >> head;
+
+                        std::fstream fs((dirA + "/" + file).c_str(),
+                                        std::ios::in | std::ios::out | std::ios::binary);
+                        const long pos = head + 100;
+                        char c;
+                        fs.seekg(pos);
+                        fs.get(c);
+                        fs.seekp(pos);
+                        fs.put(c ^ 0x10);
+                    }
+                    ParallelDescriptor::Barrier();
+
+                    if (VisMF::VerifyChecksums(nameA) < 1 || VisMF::VerifyChecksums(nameB) < 1) {
+                        amrex::Print() << "FAIL: damage not found, test " << ntest << std::endl;
+                        ++nfail;
+                    }
+
+                    ++ntest;
+                }
+            }
+        }
+
+        if (nfail > 0)
+            amrex::Abort("VisMF checksums failed");
+
+        amrex::Print() << ntest << " checksum and dedup tests passed" << std::endl;
+    }
+    amrex::Finalize();
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <cmath>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Write cell centered, nodal and face centered MultiFabs with several
+// header versions and FAB formats, then read them back with
+// VisMF::ReadChopped into MultiFabs whose boxes are the written ones
+// chopped in half, ghost cells included, as a redistributing restart
+// reads StateData.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 32;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+
+        DistributionMapping dm(ba);
+
+        // ---- the pieces, as a restart on more processors would make them
+        BoxArray chopped(ba);
+        chopped.maxSize(max_grid_size/2);
+        DistributionMapping choppeddm(chopped);
+
+        const std::string dir("tVisMFChopped.dir");
+        amrex::UtilCreateCleanDirectory(dir, true);
+
+        const VisMF::Header::Version versions[] = { VisMF::Header::Version_v1,
+                                                    VisMF::Header::NoFabHeader_v1,
+                                                    VisMF::Header::Compressed_v1 };
+        const FABio::Format formats[] = { FABio::FAB_NATIVE, FABio::FAB_IEEE_32 };
+        //
+        // ---- cell centered, nodal and x-face centered data.  Like
+        // ---- StateData::restart, chop the cell centered grids and then
+        // ---- convert, so the nodal and face pieces share faces with
+        // ---- the neighboring on-disk boxes.
+        //
+        const IndexType types[] = { IndexType::TheCellType(),
+                                    IndexType::TheNodeType(),
+                                    IndexType(IntVect::TheDimensionVector(0)) };
+
+        Real maxdiff = 0.0;
+        int ntest = 0;
+
+        for (auto typ : types) {
+            const BoxArray tba(amrex::convert(ba, typ));
+            const BoxArray tchopped(amrex::convert(chopped, typ));
+
+            MultiFab mf(tba, dm, 3, 1);
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.fabbox();
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                    mf[mfi](iv,0) = std::sin(0.1*D_TERM(iv[0], + 2*iv[1], + 3*iv[2]));
+                    mf[mfi](iv,1) = 1.0 + iv[0];
+                    mf[mfi](iv,2) = std::cos(0.2*D_TERM(iv[0], - iv[1], + iv[2]));
+                }
+            }
+
+            for (auto version : versions) {
+                for (auto format : formats) {
+                    VisMF::SetHeaderVersion(version);
+                    FArrayBox::setFormat(format);
+
+                    const std::string name = amrex::Concatenate(dir + "/mf", ntest++, 2);
+
+                    VisMF::Write(mf, name);
+
+                    MultiFab mf2(tchopped, choppeddm, 3, 1);
+                    VisMF::ReadChopped(mf2, name);
+
+                    const Real tol = (format == FABio::FAB_NATIVE) ? 0.0 : 1.e-6;
+
+                    // ---- the ghost cells too
+                    for (MFIter mfi(mf2); mfi.isValid(); ++mfi)
+                    {
+                        const Box& bx = mfi.fabbox();
+                        for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                            Real d = std::abs(mf2[mfi](iv,0) - std::sin(0.1*D_TERM(iv[0], + 2*iv[1], + 3*iv[2])));
+                            d = std::max(d, std::abs(mf2[mfi](iv,1) - (1.0 + iv[0])) / (1.0 + ncell));
+                            d = std::max(d, std::abs(mf2[mfi](iv,2) - std::cos(0.2*D_TERM(iv[0], - iv[1], + iv[2]))));
+                            if (d > tol) maxdiff = std::max(maxdiff, d);
+                        }
+                    }
+                }
+            }
+        }
+
+        ParallelDescriptor::ReduceRealMax(maxdiff);
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << ntest << " MultiFabs read in " << chopped.size()
+                      << " pieces, max difference beyond tolerance: "
+                      << maxdiff << std::endl;
+
+        if (maxdiff > 0.0)
+            amrex::Abort("VisMF::ReadChopped failed");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
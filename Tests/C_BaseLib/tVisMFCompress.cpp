@@ -0,0 +1,121 @@
+#include <iostream>
+#include <cmath>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Write MultiFabs in the Compressed_v1 format with both codecs, with
+// Write and AsyncWrite, then read them back whole and by component.
+// The lossless codec must reproduce the data, the error bounded codec
+// must stay within its tolerance.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 16;
+        Real tol = 1.e-4;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("tol", tol);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba, dm, 3, 1);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.fabbox();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                mf[mfi](iv,0) = std::sin(0.1*D_TERM(iv[0], + 2*iv[1], + 3*iv[2]));
+                mf[mfi](iv,1) = 1.0 + iv[0];
+                mf[mfi](iv,2) = (iv[1] > ncell/2) ? 1.e30 : -1.e-30;
+            }
+        }
+
+        const std::string dir("tVisMFCompress.dir");
+        amrex::UtilCreateCleanDirectory(dir, true);
+
+        VisMF::SetHeaderVersion(VisMF::Header::Compressed_v1);
+        VisMF::SetCodecTolerance(tol);
+
+        const VisMF::Codec codecs[] = { VisMF::LosslessCodec, VisMF::ErrorBoundedCodec };
+        const FABio::Format formats[] = { FABio::FAB_NATIVE, FABio::FAB_IEEE_32 };
+        const int nfiles[] = { 1, ParallelDescriptor::NProcs() };
+
+        Real maxerr = 0.0;
+        int ntest = 0;
+
+        for (auto codec : codecs) {
+            for (auto format : formats) {
+                for (auto nf : nfiles) {
+                    for (int async = 0; async < 2; ++async) {
+                        VisMF::SetCodec(codec);
+                        FArrayBox::setFormat(format);
+                        VisMF::SetNOutFiles(nf);
+
+                        const std::string name = amrex::Concatenate(dir + "/mf", ntest++, 2);
+
+                        if (async) {
+                            VisMF::AsyncWrite(mf, name);
+                        } else {
+                            VisMF::Write(mf, name);
+                        }
+
+                        MultiFab mf2(ba, dm, 3, 1);
+                        VisMF::Read(mf2, name);
+
+                        // ---- the allowed absolute and relative errors
+                        const Real atol = (codec == VisMF::ErrorBoundedCodec) ? tol : 0.0;
+                        const Real rtol = (codec == VisMF::LosslessCodec &&
+                                           format == FABio::FAB_IEEE_32) ? 1.e-6 : 0.0;
+
+                        VisMF vmf(name);
+                        for (MFIter mfi(mf2); mfi.isValid(); ++mfi) {
+                            const int i = mfi.index();
+                            const Box& bx = mfi.fabbox();
+                            for (int n = 0; n < 3; ++n) {
+                                const FArrayBox& cfab = vmf.GetFab(i, n);
+                                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                                    const Real v = mf[mfi](iv,n);
+                                    const Real e = std::max(std::abs(mf2[mfi](iv,n) - v),
+                                                            std::abs(cfab(iv,0) - v));
+                                    if (e > atol + rtol * std::abs(v))
+                                        maxerr = std::max(maxerr, e);
+                                }
+                                vmf.clear(i, n);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        ParallelDescriptor::ReduceRealMax(maxerr);
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << ntest << " MultiFabs written, max error beyond tolerance: "
+                      << maxerr << std::endl;
+
+        if (maxerr > 0.0)
+            amrex::Abort("Compressed_v1 VisMF failed");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <cmath>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Read MultiFabs written with each header version and FAB format back
+// one FAB and one component at a time through memory mapped VisMFs.
+// Native data is aliased, everything else falls back to reading.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba, dm, 2, 1);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.fabbox();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                mf[mfi](iv,0) = std::sin(0.1*D_TERM(iv[0], + 2*iv[1], + 3*iv[2]));
+                mf[mfi](iv,1) = 1.0 + iv[0];
+            }
+        }
+
+        const std::string dir("tVisMFMap.dir");
+        amrex::UtilCreateCleanDirectory(dir, true);
+
+        const VisMF::Header::Version versions[] = { VisMF::Header::Version_v1,
+                                                    VisMF::Header::NoFabHeader_v1,
+                                                    VisMF::Header::Compressed_v1 };
+        const FABio::Format formats[] = { FABio::FAB_NATIVE, FABio::FAB_IEEE_32 };
+
+        VisMF::SetUseMemoryMap(true);
+
+        Real maxdiff = 0.0;
+        int ntest = 0;
+
+        for (auto version : versions) {
+            for (auto format : formats) {
+                VisMF::SetHeaderVersion(version);
+                FArrayBox::setFormat(format);
+
+                const std::string name = amrex::Concatenate(dir + "/mf", ntest++, 2);
+
+                VisMF::Write(mf, name);
+
+                const Real tol = (format == FABio::FAB_NATIVE) ? 0.0 : 1.e-6;
+
+                VisMF vmf(name);
+                for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                    const int i = mfi.index();
+                    for (int n = 0; n < mf.nComp(); ++n) {
+                        FArrayBox fab(mf[mfi].box(), 1);
+                        fab.copy(vmf.GetFab(i, n), 0, 0, 1);
+                        fab.minus(mf[mfi], n, 0, 1);
+                        Real d = fab.norm(0) / (1.0 + ncell);
+                        if (d > tol) maxdiff = std::max(maxdiff, d);
+                    }
+                    FArrayBox* whole = vmf.readFAB(i, name);
+                    FArrayBox fab(mf[mfi].box(), mf.nComp());
+                    fab.copy(*whole);
+                    fab.minus(mf[mfi]);
+                    Real d = fab.norm(0, 0, mf.nComp()) / (1.0 + ncell);
+                    if (d > tol) maxdiff = std::max(maxdiff, d);
+                    delete whole;
+                }
+                vmf.clear();
+            }
+        }
+
+        ParallelDescriptor::ReduceRealMax(maxdiff);
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << ntest << " MultiFabs read through memory maps, max difference beyond tolerance: "
+                      << maxdiff << std::endl;
+
+        if (maxdiff > 0.0)
+            amrex::Abort("memory mapped VisMF reads failed");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
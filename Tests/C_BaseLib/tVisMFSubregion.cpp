@@ -0,0 +1,119 @@
+#include <iostream>
+#include <cmath>
+#include <AMReX_BoxArray.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_Utility.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+
+using namespace amrex;
+
+//
+// Write a MultiFab, with and without ghost cells, with several header
+// versions and FAB formats, then read slabs and a small box, two of its
+// three components, into MultiFabs with other BoxArrays and
+// DistributionMappings.  Without ghost cells the slab with the same
+// grids in the lower directions is read in whole planes.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int max_grid_size = 16;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+        }
+
+        Box domain(IntVect(D_DECL(0,0,0)), IntVect(D_DECL(ncell-1,ncell-1,ncell-1)));
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+
+        DistributionMapping dm(ba);
+
+        MultiFab mfs[2];
+        for (int ngrow = 0; ngrow < 2; ++ngrow)
+        {
+            MultiFab& mf = mfs[ngrow];
+            mf.define(ba, dm, 3, ngrow);
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.fabbox();
+                for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv)) {
+                    mf[mfi](iv,0) = std::sin(0.1*D_TERM(iv[0], + 2*iv[1], + 3*iv[2]));
+                    mf[mfi](iv,1) = 1.0 + iv[0];
+                    mf[mfi](iv,2) = std::cos(0.2*D_TERM(iv[0], - iv[1], + iv[2]));
+                }
+            }
+        }
+
+        // ---- a slab in the last direction and a box inside the domain
+        Box slab(domain);
+        slab.setSmall(BL_SPACEDIM-1, ncell/2 - 1);
+        slab.setBig(BL_SPACEDIM-1, ncell/2 + 2);
+        Box inner(domain);
+        inner.grow(-ncell/4);
+        inner.shift(0, 3);
+
+        const int nsub = 3;
+        BoxArray sub[nsub] = { BoxArray(slab), BoxArray(inner), BoxArray(slab) };
+        sub[0].maxSize(max_grid_size/2);
+        sub[1].maxSize(max_grid_size + 4);
+        sub[2].maxSize(max_grid_size);
+
+        const std::string dir("tVisMFSubregion.dir");
+        amrex::UtilCreateCleanDirectory(dir, true);
+
+        const VisMF::Header::Version versions[] = { VisMF::Header::Version_v1,
+                                                    VisMF::Header::NoFabHeader_v1,
+                                                    VisMF::Header::Compressed_v1 };
+        const FABio::Format formats[] = { FABio::FAB_NATIVE, FABio::FAB_IEEE_32 };
+
+        Real maxdiff = 0.0;
+        int ntest = 0;
+
+        for (const MultiFab& mf : mfs) {
+            for (auto version : versions) {
+                for (auto format : formats) {
+                    VisMF::SetHeaderVersion(version);
+                    FArrayBox::setFormat(format);
+
+                    const std::string name = amrex::Concatenate(dir + "/mf", ntest++, 2);
+
+                    VisMF::Write(mf, name);
+
+                    const Real tol = (format == FABio::FAB_NATIVE) ? 0.0 : 1.e-6;
+
+                    for (int isub = 0; isub < nsub; ++isub) {
+                        DistributionMapping subdm(sub[isub]);
+
+                        MultiFab mf2(sub[isub], subdm, 2, 0);
+                        VisMF::ReadSubregion(mf2, name, 1, 0, 2);
+
+                        MultiFab ref(sub[isub], subdm, 2, 0);
+                        ref.copy(mf, 1, 0, 2);
+
+                        MultiFab::Subtract(mf2, ref, 0, 0, 2, 0);
+                        Real d = std::max(mf2.norm0(0), mf2.norm0(1)) / (1.0 + ncell);
+                        if (d > tol) maxdiff = std::max(maxdiff, d);
+                    }
+                }
+            }
+        }
+
+        if (ParallelDescriptor::IOProcessor())
+            std::cout << nsub*ntest << " subregions read, max difference beyond tolerance: "
+                      << maxdiff << std::endl;
+
+        if (maxdiff > 0.0)
+            amrex::Abort("VisMF::ReadSubregion failed");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
@@ -0,0 +1,329 @@
+#include <iostream>
+#include <vector>
+#include <list>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_BoxDomain.H>
+#include <AMReX_TagBox.H>
+#include <AMReX_Cluster.H>
+
+using namespace amrex;
+
+namespace
+{
+    //
+    // The clustering as it was done with one IntVect per tagged cell,
+    // before the tags were clustered as runs.  FindCut is a copy of the
+    // one in AMReX_Cluster.cpp.
+    //
+    enum CutStatus { HoleCut=0, SteepCut, BisectCut, InvalidCut };
+
+    int
+    FindCut (const int* hist,
+             int        lo,
+             int        hi,
+             CutStatus& status)
+    {
+        const int MINOFF     = 2;
+        const int CUT_THRESH = 2;
+
+        status = InvalidCut;
+        int len = hi - lo + 1;
+
+        if (len <= 1)
+            return lo;
+
+        int mid = len/2;
+        int cutpoint = -1;
+        int i;
+        for (i = 0; i < len; i++)
+        {
+            if (hist[i] == 0)
+            {
+                status = HoleCut;
+                if (std::abs(cutpoint-mid) > std::abs(i-mid))
+                {
+                    cutpoint = i;
+                    if (i > mid)
+                        break;
+                }
+            }
+        }
+        if (status == HoleCut)
+            return lo + cutpoint;
+
+        std::vector<int> dhist(len,0);
+        for (i = 1; i < len-1; i++)
+            dhist[i] = hist[i+1] - 2*hist[i] + hist[i-1];
+
+        int locmax = -1;
+        for (i = 0+MINOFF; i < len-MINOFF; i++)
+        {
+            int iprev  = dhist[i-1];
+            int icur   = dhist[i];
+            int locdif = std::abs(iprev-icur);
+            if (iprev*icur < 0 && locdif >= locmax)
+            {
+                if (locdif > locmax)
+                {
+                    status   = SteepCut;
+                    cutpoint = i;
+                    locmax   = locdif;
+                }
+                else
+                {
+                    if (std::abs(i-mid) < std::abs(cutpoint-mid))
+                        cutpoint = i;
+                }
+            }
+        }
+
+        if (locmax <= CUT_THRESH)
+        {
+            cutpoint = mid;
+            status = BisectCut;
+        }
+
+        return lo + cutpoint;
+    }
+
+    struct PointCluster
+    {
+        std::vector<IntVect> pts;
+        Box                  bx;
+
+        void minBox ()
+        {
+            IntVect lo = pts[0], hi = lo;
+            for (const auto& p : pts)
+            {
+                lo.min(p);
+                hi.max(p);
+            }
+            bx = Box(lo,hi);
+        }
+
+        Real eff () const { return pts.size()/bx.d_numPts(); }
+        //
+        // Splits off and returns the points on the high side of the cut.
+        //
+        PointCluster chop ()
+        {
+            const IntVect lo = bx.smallEnd(), hi = bx.bigEnd();
+
+            std::vector<int> hist[BL_SPACEDIM];
+            for (int n = 0; n < BL_SPACEDIM; n++)
+                hist[n].assign(bx.length(n), 0);
+            for (const auto& p : pts)
+                for (int n = 0; n < BL_SPACEDIM; n++)
+                    hist[n][p[n]-lo[n]]++;
+
+            CutStatus mincut = InvalidCut;
+            CutStatus status[BL_SPACEDIM];
+            IntVect cut;
+            for (int n = 0; n < BL_SPACEDIM; n++)
+            {
+                cut[n] = FindCut(hist[n].data(), lo[n], hi[n], status[n]);
+                mincut = std::min(mincut, status[n]);
+            }
+
+            int dir = -1;
+            for (int n = 0, minlen = -1; n < BL_SPACEDIM; n++)
+            {
+                if (status[n] == mincut)
+                {
+                    int mincutlen = std::min(cut[n]-lo[n],hi[n]-cut[n]);
+                    if (mincutlen >= minlen)
+                    {
+                        dir = n;
+                        minlen = mincutlen;
+                    }
+                }
+            }
+
+            PointCluster c;
+            std::vector<IntVect> lopts;
+            for (const auto& p : pts)
+            {
+                if (p[dir] < cut[dir])
+                    lopts.push_back(p);
+                else
+                    c.pts.push_back(p);
+            }
+            pts.swap(lopts);
+            minBox();
+            c.minBox();
+            return c;
+        }
+    };
+
+    BoxList
+    pointClusters (const std::vector<IntVect>& tags,
+                   Real                        grid_eff,
+                   const BoxDomain&            bd)
+    {
+        std::list<PointCluster> lst(1);
+        lst.front().pts = tags;
+        lst.front().minBox();
+
+        for (auto it = lst.begin(); it != lst.end(); )
+        {
+            if (it->eff() < grid_eff)
+                lst.push_back(it->chop());
+            else
+                ++it;
+        }
+
+        BoxArray domba(bd.boxList());
+
+        for (auto it = lst.begin(); it != lst.end(); )
+        {
+            if (domba.contains(it->bx,true))
+            {
+                ++it;
+                continue;
+            }
+
+            BoxDomain bxdom;
+            amrex::intersect(bxdom, bd, it->bx);
+
+            for (BoxDomain::const_iterator bdi = bxdom.begin(); bdi != bxdom.end(); ++bdi)
+            {
+                PointCluster c;
+                for (const auto& p : it->pts)
+                    if (bdi->contains(p))
+                        c.pts.push_back(p);
+                if (!c.pts.empty())
+                {
+                    c.minBox();
+                    lst.push_back(c);
+                }
+            }
+
+            lst.erase(it++);
+        }
+
+        BoxList bl;
+        for (const auto& c : lst)
+            bl.push_back(c.bx);
+        return bl;
+    }
+
+    bool
+    sameBoxes (const BoxList& a, const BoxList& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (BoxList::const_iterator ai = a.begin(), bi = b.begin(); ai != a.end(); ++ai, ++bi)
+            if (*ai != *bi)
+                return false;
+        return true;
+    }
+}
+
+//
+// Cluster a fixed pattern of tags -- a spherical shell, a solid block
+// and a diagonal line -- as AmrMesh::MakeNewGrids does, and check that
+// the run based clustering, from runs or from points, makes the same
+// grids, in the same order, as the clustering of one IntVect per tag.
+// The proper nesting domain has a hole, so the clusters are also
+// intersected with it.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int  ncell         = 64;
+        int  max_grid_size = 16;
+        Real grid_eff      = 0.7;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("grid_eff", grid_eff);
+        }
+        if (ncell < 16)
+            amrex::Abort("ncell must be at least 16");
+
+        const Box domain(IntVect::TheZeroVector(), (ncell-1)*IntVect::TheUnitVector());
+
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        TagBoxArray tags(ba, dm);
+        tags.setVal(TagBox::CLEAR);
+
+        const Real rc = 0.5*ncell, r0 = 0.3*ncell;
+
+        for (MFIter mfi(tags); mfi.isValid(); ++mfi)
+        {
+            TagBox&    tb = tags[mfi];
+            const Box& bx = mfi.validbox();
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+            {
+                Real r2 = 0.0;
+                for (int n = 0; n < BL_SPACEDIM; n++)
+                    r2 += (iv[n]+0.5-rc)*(iv[n]+0.5-rc);
+
+                bool tag = std::abs(std::sqrt(r2) - r0) < 1.5;
+
+                tag = tag || (iv <= IntVect(D_DECL(ncell/8,ncell/8+2,ncell/8+4)) &&
+                              iv >= IntVect(D_DECL(2,2,2)));
+
+                bool diag = true;
+                for (int n = 1; n < BL_SPACEDIM; n++)
+                    diag = diag && (iv[n] == iv[0]);
+                tag = tag || (diag && iv[0] > ncell/2);
+
+                if (tag)
+                    tb(iv) = TagBox::SET;
+            }
+        }
+
+        BoxDomain bd;
+        bd.add(domain);
+        bd.rmBox(Box(IntVect::TheZeroVector(), (ncell/4)*IntVect::TheUnitVector()));
+
+        std::vector<IntVect> tagvec;
+        tags.collate(tagvec);
+
+        std::vector<TagRun> tagruns;
+        tags.collate(tagruns);
+        const long nruns = tagruns.size();
+
+        const BoxList old_bl = pointClusters(tagvec, grid_eff, bd);
+
+        BoxList run_bl;
+        {
+            ClusterList clist(tagruns);
+            clist.chop(grid_eff);
+            clist.intersect(bd);
+            clist.boxList(run_bl);
+        }
+
+        BoxList pt_bl;
+        {
+            ClusterList clist(&tagvec[0], tagvec.size());
+            clist.chop(grid_eff);
+            clist.intersect(bd);
+            clist.boxList(pt_bl);
+        }
+
+        amrex::Print() << tagvec.size() << " tags in " << nruns << " runs, "
+                       << old_bl.size() << " grids" << std::endl;
+
+        if (!sameBoxes(old_bl, run_bl))
+            amrex::Abort("the grids from the tag runs differ");
+        if (!sameBoxes(old_bl, pt_bl))
+            amrex::Abort("the grids from the tag points differ");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_BCRec.H>
+#include <AMReX_Interpolater.H>
+
+using namespace amrex;
+
+namespace
+{
+    //
+    // Smooth data with a jump, so the limiters do something.
+    //
+    void
+    fillCoarse (FArrayBox& crse)
+    {
+        const Box& bx = crse.box();
+        for (int n = 0; n < crse.nComp(); n++)
+        {
+            for (IntVect iv = bx.smallEnd(); iv <= bx.bigEnd(); bx.next(iv))
+            {
+                const Real x = 0.05*D_TERM(iv[0], + 2*iv[1], + 3*iv[2]);
+                Real v = std::sin(x + n) + 0.1*iv[0];
+                if (iv[0] > 7) v += 2.0;
+                crse(iv,n) = v;
+            }
+        }
+    }
+
+    Real
+    maxDiff (const FArrayBox& a, const FArrayBox& b, const Box& bx)
+    {
+        FArrayBox d(bx, a.nComp());
+        d.copy(a, bx);
+        d.minus(b, bx, 0, 0, a.nComp());
+        return d.norm(bx, 0, 0, a.nComp());
+    }
+}
+
+//
+// Time the C++ kernels of the conservative linear and the node bilinear
+// interpolaters, and in 2D of the cell bilinear and quadratic ones,
+// against the Fortran ones at refinement ratios 2, 3 and 4 and check
+// they give the same values.  Component 0 has interior
+// boundaries and component 1 has EXT_DIR ones, which use the one-sided
+// slopes at the edges of the cell centered interpolaters.
+//
+int
+main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int ncell = 64;
+        int nrep  = 10;
+        {
+            ParmParse pp;
+            pp.query("ncell", ncell);
+            pp.query("nrep", nrep);
+        }
+        if (ncell < 4)
+            amrex::Abort("ncell must be at least 4");
+
+        const int ncomp = 2;
+
+        Array<BCRec> bcr(ncomp);
+        bcr[0] = BCRec(D_DECL(BCType::int_dir, BCType::int_dir, BCType::int_dir),
+                       D_DECL(BCType::int_dir, BCType::int_dir, BCType::int_dir));
+        bcr[1] = BCRec(D_DECL(BCType::ext_dir, BCType::ext_dir, BCType::ext_dir),
+                       D_DECL(BCType::ext_dir, BCType::ext_dir, BCType::hoextrap));
+
+        Interpolater* interps[] = { &cell_cons_interp, &lincc_interp, &protected_interp,
+                                    &node_bilinear_interp
+#if (BL_SPACEDIM == 2)
+                                    , &cell_bilinear_interp, &quadratic_interp
+#endif
+                                  };
+        const char*   names[]   = { "cell_cons_interp", "lincc_interp", "protected_interp",
+                                    "node_bilinear_interp"
+#if (BL_SPACEDIM == 2)
+                                    , "cell_bilinear_interp", "quadratic_interp"
+#endif
+                                  };
+        const bool    nodal[]   = { false, false, false, true
+#if (BL_SPACEDIM == 2)
+                                    , false, false
+#endif
+                                  };
+        const int     ninterp   = sizeof(interps)/sizeof(interps[0]);
+        const int     ratios[]  = { 2, 3, 4 };
+
+        int nfail = 0;
+
+        for (int r : ratios)
+        {
+            const IntVect ratio = r*IntVect::TheUnitVector();
+            //
+            // A coarse domain with negative indices, and a fine region
+            // that does not start or end on a coarse cell.
+            //
+            const Box cdomain(IntVect(D_DECL(-8,-8,-8)), IntVect(D_DECL(ncell-9,ncell-9,ncell-9)));
+            const Box fdomain = amrex::refine(cdomain, ratio);
+
+            RealBox rb(D_DECL(0.,0.,0.), D_DECL(1.,1.,1.));
+            int is_per[BL_SPACEDIM] = {D_DECL(0,0,0)};
+            Geometry cgeom(cdomain, &rb, 0, is_per);
+            Geometry fgeom(fdomain, &rb, 0, is_per);
+
+            Box cc_region(fdomain);
+            cc_region.growLo(0,-1).growHi(0,-3);
+
+            for (int m = 0; m < ninterp; m++)
+            {
+                Interpolater* interp = interps[m];
+
+                const Box fine_region = nodal[m] ? amrex::surroundingNodes(cc_region) : cc_region;
+                const Box fine_box    = nodal[m] ? amrex::surroundingNodes(fdomain) : fdomain;
+
+                FArrayBox fine_f(fine_box, ncomp), fine_c(fine_box, ncomp);
+
+                FArrayBox crse(interp->CoarseBox(fine_region, ratio), ncomp);
+                fillCoarse(crse);
+
+                fine_f.setVal(0.0);
+                fine_c.setVal(0.0);
+
+                Real tf = 0.0, tc = 0.0;
+
+                for (int use_fortran = 1; use_fortran >= 0; use_fortran--)
+                {
+                    Interpolater::SetUseFortran(use_fortran);
+
+                    FArrayBox& fine = use_fortran ? fine_f : fine_c;
+
+                    const Real t0 = ParallelDescriptor::second();
+                    for (int i = 0; i < nrep; i++)
+                    {
+                        interp->interp(crse, 0, fine, 0, ncomp, fine_region, ratio,
+                                       cgeom, fgeom, bcr, 0, 0);
+                    }
+                    const Real t = (ParallelDescriptor::second() - t0) / nrep;
+
+                    if (use_fortran) tf = t; else tc = t;
+                }
+
+                const Real diff = maxDiff(fine_f, fine_c, fine_region);
+                const Real fmax = fine_f.norm(fine_region, 0, 0, ncomp);
+
+                amrex::Print() << names[m] << "  ratio " << r
+                               << ":  Fortran " << tf << " s,  C++ " << tc
+                               << " s,  speedup " << tf/tc
+                               << ",  max diff " << diff << std::endl;
+
+                if (diff > 1.e-12*fmax)
+                    ++nfail;
+            }
+        }
+
+        Interpolater::SetUseFortran(false);
+
+        if (nfail > 0)
+            amrex::Abort("C++ and Fortran interpolation differ");
+    }
+    amrex::Finalize();
+
+    return 0;
+}
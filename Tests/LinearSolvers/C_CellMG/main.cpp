@@ -37,8 +37,8 @@ mfnorm_2_valid (const MultiFab& mf)
     Real r = 0;
     for ( MFIter cmfi(mf); cmfi.isValid(); ++cmfi )
     {
-        Real s = mf[cmfi].norm(cmfi.validbox(), 2, 0, mf[cmfi].nComp());
-        r += s*s;
+        const Box& bx = cmfi.validbox();
+        r += mf[cmfi].dot(bx, 0, mf[cmfi], bx, 0, mf[cmfi].nComp());
     }
     ParallelDescriptor::ReduceRealSum(r);
     return ::sqrt(r);
@@ -300,6 +300,7 @@ main (int argc, char* argv[])
   bool dump_rhs_ascii=false ; pp.query("dump_rhs_ascii", dump_rhs_ascii);
 
   bool use_variable_coef=false; pp.query("use_variable_coef", use_variable_coef);
+  bool check_smooth_halo=false; pp.query("check_smooth_halo", check_smooth_halo);
 
   int res;
 
@@ -322,6 +323,37 @@ main (int argc, char* argv[])
 
 	  MultiGrid mg(lp);
 	  mg.solve(soln, rhs, tolerance, tolerance_abs);
+	  if ( check_smooth_halo )
+	  {
+	      //
+	      // Solve again with Lp.smooth_halo=1; the halo smoothing must
+	      // give the same solution bit for bit.
+	      //
+	      int nhalo = 0;
+	      for (int lev = 0; lev < mg.getNumLevels(); ++lev)
+	      {
+		  if ( ParallelDescriptor::IOProcessor() )
+		      std::cout << "MG level " << lev << ": smoothing halo "
+				<< lp.NumSmoothGrow(lev) << std::endl;
+		  if ( lp.NumSmoothGrow(lev) > lp.NumGrow(lev) )
+		      ++nhalo;
+	      }
+	      if ( nhalo == 0 )
+		  amrex::Abort("check_smooth_halo: no level used the smoothing halo");
+
+	      Laplacian lp1(bd, dx[0]);
+	      lp1.smoothHalo(1);
+	      MultiFab soln1(bs, dm, Ncomp, Nghost); soln1.setVal(0.0);
+	      MultiGrid mg1(lp1);
+	      mg1.solve(soln1, rhs, tolerance, tolerance_abs);
+
+	      MultiFab::Subtract(soln1, soln, 0, 0, Ncomp, 0);
+	      const Real diff = soln1.norm0();
+	      if ( ParallelDescriptor::IOProcessor() )
+		  std::cout << "check_smooth_halo: max difference = " << diff << std::endl;
+	      if ( diff != 0 )
+		  amrex::Abort("check_smooth_halo: solutions differ");
+	  }
 	  if ( new_bc )
           {
 	      for ( MFIter mfi(rhs); mfi.isValid(); ++mfi )
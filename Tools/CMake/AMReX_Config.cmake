@@ -163,6 +163,14 @@ if (ENABLE_OMP)
    append ( OpenMP_CXX_FLAGS AMREX_EXTRA_CXX_FLAGS )
 endif()
 
+# VisMF::AsyncWrite runs a std::thread
+find_package (Threads REQUIRED)
+if (CMAKE_THREAD_LIBS_INIT)
+   list (APPEND AMREX_EXTRA_Fortran_LINK_LINE ${CMAKE_THREAD_LIBS_INIT})
+   list (APPEND AMREX_EXTRA_C_LINK_LINE ${CMAKE_THREAD_LIBS_INIT})
+   list (APPEND AMREX_EXTRA_CXX_LINK_LINE ${CMAKE_THREAD_LIBS_INIT})
+endif ()
+
 
 # ------------------------------------------------------------- #
 #    Setup compiler flags 
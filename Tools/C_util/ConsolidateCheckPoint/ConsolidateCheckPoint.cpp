@@ -0,0 +1,334 @@
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Utility.H>
+#include <AMReX_Array.H>
+
+using namespace amrex;
+
+static
+void
+PrintUsage (const char* progName)
+{
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::cout << "This utility makes checkpoints written with amr.checkpoint_delta\n"
+                  << "whole.  The state data a delta checkpoint names in an earlier\n"
+                  << "checkpoint is copied into it and its Header is rewritten, so the\n"
+                  << "earlier checkpoints can be removed.\n";
+        std::cout << '\n';
+        std::cout << "Usage:" << '\n';
+        std::cout << progName << '\n';
+        std::cout << "    checkpoint = chk00100 [chk00200 ...]" << '\n';
+        std::cout << "   [-help]" << '\n';
+        std::cout << '\n';
+    }
+    exit(1);
+}
+
+static
+std::string
+DirName (const std::string& path)
+{
+    const std::string::size_type slash = path.rfind('/');
+    return (slash == std::string::npos) ? std::string(".") : path.substr(0, slash);
+}
+
+static
+void
+CopyFile (const std::string& src,
+          const std::string& dst)
+{
+    std::ifstream ifs(src.c_str(), std::ios::in | std::ios::binary);
+    if ( ! ifs.good())
+        amrex::FileOpenFailed(src);
+
+    std::ofstream ofs(dst.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if ( ! ofs.good())
+        amrex::FileOpenFailed(dst);
+
+    if (ifs.peek() != std::ifstream::traits_type::eof())
+        ofs << ifs.rdbuf();
+
+    if ( ! ofs.good())
+        amrex::Abort("Error writing " + dst);
+}
+
+static
+std::string
+BaseName (const std::string& path)
+{
+    const std::string::size_type slash = path.rfind('/');
+    return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+//
+// A FabArray in an earlier checkpoint, "../chk00100/Level_0/SD_0_New_MF",
+// is imported as "Level_0/SD_0_New_MF_chk00100" so it can not collide
+// with the FabArrays of this checkpoint or with the same FabArray
+// imported from another checkpoint.  Its data files get the same suffix.
+//
+static
+std::string
+ImportName (const std::string& ref,
+            const std::string& path)
+{
+    const std::string::size_type slash = ref.find('/', 3);
+    if (ref.compare(0, 3, "../") != 0 || slash == std::string::npos || slash + 1 == ref.size())
+        amrex::Abort("ConsolidateCheckPoint: bad name " + ref + " in " + path);
+
+    return ref.substr(slash + 1) + '_' + ref.substr(3, slash - 3);
+}
+
+static
+std::string
+ImportDataFile (const std::string& dataFile,
+                const std::string& src,
+                const std::string& dst)
+{
+    const std::string srcBase(BaseName(src)), dstBase(BaseName(dst));
+
+    if (dataFile.compare(0, srcBase.size(), srcBase) == 0)
+        return dstBase + dataFile.substr(srcBase.size());
+    else
+        return dstBase + '_' + dataFile;
+}
+
+//
+// The data files named in the header of the FabArray src.
+//
+static
+std::set<std::string>
+DataFiles (const std::string& src)
+{
+    std::ifstream hdr((src + "_H").c_str());
+    if ( ! hdr.good())
+        amrex::FileOpenFailed(src + "_H");
+
+    std::set<std::string> dataFiles;
+    std::string token;
+    while (hdr >> token)
+    {
+        if (token == "FabOnDisk:" && hdr >> token)
+            dataFiles.insert(token);
+    }
+    return dataFiles;
+}
+
+//
+// Copy the FabArray src to dst, renaming its data files as ImportDataFile
+// does and rewriting the FabOnDisk lines of its header to match.
+//
+static
+void
+CopyFabArray (const std::string& src,
+              const std::string& dst)
+{
+    const std::string srcDir(DirName(src)), dstDir(DirName(dst));
+
+    if ( ! amrex::UtilCreateDirectory(dstDir, 0755))
+        amrex::CreateDirectoryFailed(dstDir);
+
+    const std::set<std::string> dataFiles(DataFiles(src));
+
+    for (auto it = dataFiles.begin(); it != dataFiles.end(); ++it)
+        CopyFile(srcDir + '/' + *it, dstDir + '/' + ImportDataFile(*it, src, dst));
+
+    std::ifstream ifs((src + "_H").c_str(), std::ios::in | std::ios::binary);
+    if ( ! ifs.good())
+        amrex::FileOpenFailed(src + "_H");
+
+    std::ofstream ofs((dst + "_H").c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if ( ! ofs.good())
+        amrex::FileOpenFailed(dst + "_H");
+
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        std::istringstream is(line);
+        std::string prefix, dataFile;
+        if (is >> prefix >> dataFile && prefix == "FabOnDisk:")
+        {
+            const std::string::size_type pos = line.find(dataFile, line.find(prefix) + prefix.size());
+            line.replace(pos, dataFile.size(), ImportDataFile(dataFile, src, dst));
+        }
+        ofs << line << '\n';
+    }
+
+    if ( ! ofs.good())
+        amrex::Abort("Error writing " + dst + "_H");
+}
+
+//
+// Add the FabArrays in earlier checkpoints named in the file, the lines
+// starting with "../", to imports, mapping each to its name in this
+// checkpoint.
+//
+static
+void
+FindImports (const std::string&                  ckdir,
+             const std::string&                  fileName,
+             std::map<std::string, std::string>& imports)
+{
+    const std::string path(ckdir + '/' + fileName);
+
+    if ( ! amrex::FileExists(path))
+        return;
+
+    std::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary);
+    if ( ! ifs.good())
+        amrex::FileOpenFailed(path);
+
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (line.compare(0, 3, "../") == 0 && imports.count(line) == 0)
+            imports[line] = ImportName(line, path);
+    }
+}
+
+//
+// Replace the names of the imported FabArrays in the file by their names
+// in this checkpoint.  Returns the number replaced.
+//
+static
+int
+RewriteNames (const std::string&                        ckdir,
+              const std::string&                        fileName,
+              const std::map<std::string, std::string>& imports)
+{
+    const std::string path(ckdir + '/' + fileName);
+
+    if ( ! amrex::FileExists(path))
+        return 0;
+
+    std::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary);
+    if ( ! ifs.good())
+        amrex::FileOpenFailed(path);
+
+    std::ostringstream out;
+    std::string line;
+    int nRefs(0);
+
+    while (std::getline(ifs, line))
+    {
+        auto it = imports.find(line);
+        if (it != imports.end())
+        {
+            line = it->second;
+            ++nRefs;
+        }
+        out << line << '\n';
+    }
+    ifs.close();
+
+    if (nRefs > 0)
+    {
+        const std::string tmpPath(path + ".new");
+        std::ofstream ofs(tmpPath.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+        if ( ! ofs.good())
+            amrex::FileOpenFailed(tmpPath);
+        ofs << out.str();
+        ofs.close();
+        if ( ! ofs.good())
+            amrex::Abort("Error writing " + tmpPath);
+        if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+            amrex::Abort("ConsolidateCheckPoint: can not rename " + tmpPath);
+    }
+
+    return nRefs;
+}
+
+//
+// Import the FabArrays that the checkpoint names in earlier checkpoints
+// and rewrite its Header and FabArrayHeaders.txt.  Every name is checked
+// before anything is written, so a collision leaves the checkpoint as it
+// was.
+//
+static
+void
+Consolidate (const std::string& ckdir)
+{
+    //
+    // The Header names each FabArray; FabArrayHeaders.txt, if
+    // any, names the same ones.
+    //
+    std::map<std::string, std::string> imports;
+    FindImports(ckdir, "Header", imports);
+    FindImports(ckdir, "FabArrayHeaders.txt", imports);
+
+    for (auto it = imports.begin(); it != imports.end(); ++it)
+    {
+        const std::string src(ckdir + '/' + it->first), dst(ckdir + '/' + it->second);
+
+        if (amrex::FileExists(dst + "_H"))
+            amrex::Abort("ConsolidateCheckPoint: " + dst + "_H already exists");
+
+        const std::set<std::string> dataFiles(DataFiles(src));
+        for (auto df = dataFiles.begin(); df != dataFiles.end(); ++df)
+        {
+            const std::string dstFile(DirName(dst) + '/' + ImportDataFile(*df, src, dst));
+            if (amrex::FileExists(dstFile))
+                amrex::Abort("ConsolidateCheckPoint: " + dstFile + " already exists");
+        }
+    }
+
+    for (auto it = imports.begin(); it != imports.end(); ++it)
+    {
+        std::cout << "  " << it->first << " -> " << it->second << std::endl;
+        CopyFabArray(ckdir + '/' + it->first, ckdir + '/' + it->second);
+    }
+
+    const int nRefs = RewriteNames(ckdir, "Header", imports);
+    RewriteNames(ckdir, "FabArrayHeaders.txt", imports);
+
+    std::cout << "  " << nRefs << " names replaced, "
+              << imports.size() << " FabArrays copied" << std::endl;
+}
+
+int
+main (int   argc,
+      char* argv[])
+{
+    if (argc == 1)
+        PrintUsage(argv[0]);
+
+    amrex::Initialize(argc,argv);
+
+    ParmParse pp;
+
+    if (pp.contains("help"))
+        PrintUsage(argv[0]);
+
+    const int nCheckPoints = pp.countval("checkpoint");
+    if (nCheckPoints == 0)
+        amrex::Abort("You must specify `checkpoint'");
+
+    if (ParallelDescriptor::IOProcessor())
+    {
+        for (int n = 0; n < nCheckPoints; ++n)
+        {
+            std::string ckdir;
+            pp.get("checkpoint", ckdir, n);
+            while (ckdir.size() > 1 && ckdir[ckdir.size()-1] == '/')
+                ckdir.erase(ckdir.size()-1);
+
+            std::cout << "Consolidating " << ckdir << std::endl;
+
+            Consolidate(ckdir);
+        }
+    }
+
+    amrex::Finalize();
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+#!/bin/bash
+#
+# Consolidate a two step chain of delta checkpoints and check that a
+# restart from it, with the earlier checkpoints removed, matches a
+# restart from the chain.  In the chain the Old state of each checkpoint
+# is the New state of the one before, which has the same name there.
+#
+# Usage: testDeltaChain.sh ConsolidateCheckPoint.exe amr.exe inputs [args ...]
+#
+# The extra args go to amr.exe.  Set MPIRUN, e.g. "mpirun -np 2", to
+# launch amr.exe.
+#
+set -e
+
+if [ $# -lt 3 ]; then
+    echo "Usage: $0 ConsolidateCheckPoint.exe amr.exe inputs [args ...]"
+    exit 1
+fi
+
+consolidate=$(readlink -f $1)
+amr=$(readlink -f $2)
+inputs=$(readlink -f $3)
+shift 3
+
+rm -rf testDeltaChain.dir
+mkdir testDeltaChain.dir
+cd testDeltaChain.dir
+[ -f ../probin ] && cp ../probin .
+
+run () {
+    $MPIRUN $amr $inputs amr.checkpoint_files_output=1 amr.plot_files_output=0 "$@" > /dev/null
+}
+
+# ---- chk00000 is whole, chk00001 and chk00002 are deltas
+mkdir chain
+run "$@" max_step=2 amr.check_int=1 amr.checkpoint_delta=1 amr.check_file=chain/chk
+
+if ! grep -q '^\.\./' chain/chk00001/Header chain/chk00002/Header; then
+    echo "testDeltaChain: the checkpoints are not deltas"
+    exit 1
+fi
+
+cp -r chain consolidated
+$consolidate checkpoint=consolidated/chk00001 consolidated/chk00002
+rm -rf consolidated/chk00000 consolidated/chk00001
+
+if grep -q '^\.\./' consolidated/chk00002/Header; then
+    echo "testDeltaChain: consolidated/chk00002 still names other checkpoints"
+    exit 1
+fi
+
+for d in chain consolidated; do
+    run "$@" max_step=4 amr.check_int=4 amr.checkpoint_delta=0 \
+        amr.restart=$d/chk00002 amr.check_file=$d/out
+done
+
+nfiles=0
+for f in $(cd chain/out00004 && find . -name 'SD_*_D_*'); do
+    cmp chain/out00004/$f consolidated/out00004/$f
+    nfiles=$((nfiles+1))
+done
+
+if [ $nfiles -eq 0 ]; then
+    echo "testDeltaChain: no state data to compare"
+    exit 1
+fi
+
+echo "testDeltaChain: $nfiles state data files match"
@@ -0,0 +1,149 @@
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+#include <dirent.h>
+
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_VisMF.H>
+#include <AMReX_Utility.H>
+
+using namespace amrex;
+
+static
+void
+PrintUsage (const char* progName)
+{
+    if (ParallelDescriptor::IOProcessor())
+    {
+        std::cout << "This utility checks the data files of FabArrays written with\n"
+                  << "vismf.checksums = 1 against the FAB checksums in their headers.\n"
+                  << "The FABs are split among the processors.  The FabArrays are\n"
+                  << "named directly or found in the directories of a plotfile or\n"
+                  << "checkpoint.  The exit status is 1 if any FAB is bad.\n";
+        std::cout << '\n';
+        std::cout << "Usage:" << '\n';
+        std::cout << progName << '\n';
+        std::cout << "   [mf = plt00100/Level_0/Cell ...]" << '\n';
+        std::cout << "   [dir = plt00100 chk00100 ...]" << '\n';
+        std::cout << "   [-help]" << '\n';
+        std::cout << '\n';
+    }
+    exit(1);
+}
+
+//
+// The names of the FabArrays, "name" for each "name_H", in dir and
+// its subdirectories.
+//
+static
+void
+FindFabArrays (const std::string&        dir,
+               std::vector<std::string>& names)
+{
+    DIR* dp = opendir(dir.c_str());
+    if (dp == 0)
+        return;
+
+    std::vector<std::string> entries;
+    while (dirent* ep = readdir(dp))
+    {
+        const std::string entry(ep->d_name);
+        if (entry != "." && entry != "..")
+            entries.push_back(entry);
+    }
+    closedir(dp);
+
+    std::sort(entries.begin(), entries.end());
+
+    for (const auto& entry : entries)
+    {
+        const std::string path(dir + '/' + entry);
+        if (entry.size() > 2 && entry.compare(entry.size() - 2, 2, "_H") == 0)
+            names.push_back(path.substr(0, path.size() - 2));
+        else
+            FindFabArrays(path, names);
+    }
+}
+
+int
+main (int   argc,
+      char* argv[])
+{
+    if (argc == 1)
+        PrintUsage(argv[0]);
+
+    amrex::Initialize(argc,argv);
+
+    ParmParse pp;
+
+    if (pp.contains("help"))
+        PrintUsage(argv[0]);
+
+    std::vector<std::string> names;
+
+    for (int n = 0, N = pp.countval("mf"); n < N; ++n)
+    {
+        std::string name;
+        pp.get("mf", name, n);
+        names.push_back(name);
+    }
+
+    for (int n = 0, N = pp.countval("dir"); n < N; ++n)
+    {
+        std::string dir;
+        pp.get("dir", dir, n);
+        while (dir.size() > 1 && dir[dir.size()-1] == '/')
+            dir.erase(dir.size()-1);
+        //
+        // Only the I/O processor looks at the directories.
+        //
+        std::vector<std::string> found;
+        if (ParallelDescriptor::IOProcessor())
+            FindFabArrays(dir, found);
+
+        std::string list;
+        for (const auto& name : found)
+            list += name + '\n';
+        int len = list.size();
+        ParallelDescriptor::Bcast(&len, 1);
+        list.resize(len);
+        ParallelDescriptor::Bcast(&list[0], len);
+
+        for (std::string::size_type pos = 0, nl; (nl = list.find('\n', pos)) != std::string::npos; pos = nl + 1)
+            names.push_back(list.substr(pos, nl - pos));
+    }
+
+    if (names.empty())
+        amrex::Abort("You must specify `mf' or `dir'");
+
+    int nBadTotal = 0;
+
+    for (const auto& name : names)
+    {
+        const Real t0 = ParallelDescriptor::second();
+
+        const int nBad = VisMF::VerifyChecksums(name);
+
+        Real dt = ParallelDescriptor::second() - t0;
+        ParallelDescriptor::ReduceRealMax(dt);
+
+        if (nBad < 0)
+            amrex::Print() << name << ":  no checksums" << std::endl;
+        else if (nBad == 0)
+            amrex::Print() << name << ":  ok  (" << dt << "s)" << std::endl;
+        else
+            amrex::Print() << name << ":  " << nBad << " bad FABs" << std::endl;
+
+        if (nBad > 0)
+            nBadTotal += nBad;
+    }
+
+    amrex::Finalize();
+
+    return (nBadTotal > 0) ? 1 : 0;
+}